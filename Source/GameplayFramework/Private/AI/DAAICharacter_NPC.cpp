@@ -92,6 +92,7 @@ void ADAAICharacter_NPC::BroadcastAttributeInfo(const FGameplayTag& AttributeTag
 {
 	check(AttributeInfo);
 	
+	// Copy, the broadcast carries this attribute's current value
 	FDaAttributeData AttributeData = AttributeInfo->FindAttributeInfoForTag(AttributeTag);
 	AttributeData.AttributeValue = Attribute.GetNumericValue(AttributeSet);
 	OnNPCAttributeChanged.Broadcast(AttributeData);
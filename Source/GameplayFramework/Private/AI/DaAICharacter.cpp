@@ -5,6 +5,7 @@
 
 #include "AbilitySystemComponent.h"
 #include "AIController.h"
+#include "AI/DaBotRegistrySubsystem.h"
 #include "BrainComponent.h"
 #include "CoreGameplayTags.h"
 #include "AbilitySystem/DaAbilitySystemComponent.h"
@@ -58,6 +59,34 @@ void ADaAICharacter::PostInitializeComponents()
 	AIPerceptionComp->OnTargetPerceptionUpdated.AddDynamic(this, &ADaAICharacter::OnTargetPerceptionUpdated);
 }
 
+void ADaAICharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UDaBotRegistrySubsystem* Registry = UDaBotRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterBot(this);
+	}
+}
+
+void ADaAICharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDaBotRegistrySubsystem* Registry = UDaBotRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterBot(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FGameplayTagContainer ADaAICharacter::GetRegistryTags() const
+{
+	FGameplayTagContainer Tags;
+	Tags.AddTag(CharacterTypeGameplayTag);
+	Tags.AddTag(CharacterIDGameplayTag);
+	return Tags;
+}
+
 void ADaAICharacter::InitAbilitySystem()
 {
 	AbilitySystemComponent->InitAbilityActorInfo(this, this);
@@ -149,6 +178,11 @@ void ADaAICharacter::OnDeathStarted(AActor* OwningActor, AActor* InstigatorActor
 		AIController->GetBrainComponent()->StopLogic("Killed");
 	}
 
+	if (UDaBotRegistrySubsystem* Registry = UDaBotRegistrySubsystem::Get(this))
+	{
+		Registry->MarkBotDead(this);
+	}
+
 	// Call super to ragdoll
 	Super::OnDeathStarted(OwningActor, InstigatorActor);
 }
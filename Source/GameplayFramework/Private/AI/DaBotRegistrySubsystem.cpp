@@ -0,0 +1,183 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "AI/DaBotRegistrySubsystem.h"
+
+#include "AI/DaAICharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+UDaBotRegistrySubsystem* UDaBotRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	return World ? World->GetSubsystem<UDaBotRegistrySubsystem>() : nullptr;
+}
+
+void UDaBotRegistrySubsystem::RegisterBot(ADaAICharacter* Bot)
+{
+	if (!Bot || Records.Contains(Bot))
+	{
+		return;
+	}
+
+	FBotRecord& Record = Records.Add(Bot);
+	Record.Tags = Bot->GetRegistryTags();
+	AddToList(Bot, Record, true);
+	AdjustAliveCounts(Record, 1);
+}
+
+void UDaBotRegistrySubsystem::UnregisterBot(ADaAICharacter* Bot)
+{
+	FBotRecord Record;
+	if (!Records.RemoveAndCopyValue(Bot, Record))
+	{
+		return;
+	}
+
+	if (Record.bAlive)
+	{
+		AdjustAliveCounts(Record, -1);
+	}
+	RemoveFromList(Record);
+}
+
+void UDaBotRegistrySubsystem::MarkBotDead(ADaAICharacter* Bot)
+{
+	FBotRecord* Record = Records.Find(Bot);
+	if (!Record || !Record->bAlive)
+	{
+		return;
+	}
+
+	AdjustAliveCounts(*Record, -1);
+	RemoveFromList(*Record);
+	AddToList(Bot, *Record, false);
+}
+
+void UDaBotRegistrySubsystem::SetBotMonsterId(ADaAICharacter* Bot, const FPrimaryAssetId& MonsterId)
+{
+	FBotRecord* Record = Records.Find(Bot);
+	if (!Record || Record->MonsterId == MonsterId)
+	{
+		return;
+	}
+
+	if (Record->bAlive)
+	{
+		AdjustAliveCounts(*Record, -1);
+		Record->MonsterId = MonsterId;
+		AdjustAliveCounts(*Record, 1);
+	}
+	else
+	{
+		Record->MonsterId = MonsterId;
+	}
+}
+
+int32 UDaBotRegistrySubsystem::GetAliveCountForMonster(FPrimaryAssetId MonsterId) const
+{
+	const int32* Count = AliveByMonster.Find(MonsterId);
+	return Count ? *Count : 0;
+}
+
+int32 UDaBotRegistrySubsystem::GetAliveCountForTag(FGameplayTag Tag) const
+{
+	// One entry per distinct tag in play (a handful), and children count toward their parents
+	int32 Total = 0;
+	for (const TPair<FGameplayTag, int32>& Pair : AliveByTag)
+	{
+		if (Pair.Key.MatchesTag(Tag))
+		{
+			Total += Pair.Value;
+		}
+	}
+	return Total;
+}
+
+TArray<ADaAICharacter*> UDaBotRegistrySubsystem::GetAliveBots() const
+{
+	TArray<ADaAICharacter*> Result;
+	Result.Reserve(AliveBots.Num());
+	for (const TWeakObjectPtr<ADaAICharacter>& Bot : AliveBots)
+	{
+		if (ADaAICharacter* Resolved = Bot.Get())
+		{
+			Result.Add(Resolved);
+		}
+	}
+	return Result;
+}
+
+void UDaBotRegistrySubsystem::ForEachAliveBot(TFunctionRef<void(ADaAICharacter&)> Visit) const
+{
+	for (const TWeakObjectPtr<ADaAICharacter>& Bot : AliveBots)
+	{
+		if (ADaAICharacter* Resolved = Bot.Get())
+		{
+			Visit(*Resolved);
+		}
+	}
+}
+
+void UDaBotRegistrySubsystem::ForEachDeadBot(TFunctionRef<void(ADaAICharacter&)> Visit) const
+{
+	for (const TWeakObjectPtr<ADaAICharacter>& Bot : DeadBots)
+	{
+		if (ADaAICharacter* Resolved = Bot.Get())
+		{
+			Visit(*Resolved);
+		}
+	}
+}
+
+void UDaBotRegistrySubsystem::AddToList(ADaAICharacter* Bot, FBotRecord& Record, bool bAlive)
+{
+	TArray<TWeakObjectPtr<ADaAICharacter>>& List = bAlive ? AliveBots : DeadBots;
+	Record.bAlive = bAlive;
+	Record.Index = List.Add(Bot);
+}
+
+void UDaBotRegistrySubsystem::RemoveFromList(FBotRecord& Record)
+{
+	TArray<TWeakObjectPtr<ADaAICharacter>>& List = Record.bAlive ? AliveBots : DeadBots;
+	const int32 Index = Record.Index;
+	if (!List.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	// Swap-remove, then point the moved bot's record at its new slot
+	List.RemoveAtSwap(Index);
+	if (List.IsValidIndex(Index))
+	{
+		if (FBotRecord* Moved = Records.Find(List[Index].GetEvenIfUnreachable()))
+		{
+			Moved->Index = Index;
+		}
+	}
+	Record.Index = INDEX_NONE;
+}
+
+void UDaBotRegistrySubsystem::AdjustAliveCounts(const FBotRecord& Record, int32 Delta)
+{
+	if (Record.MonsterId.IsValid())
+	{
+		int32& Count = AliveByMonster.FindOrAdd(Record.MonsterId);
+		Count += Delta;
+		if (Count <= 0)
+		{
+			AliveByMonster.Remove(Record.MonsterId);
+		}
+	}
+
+	for (const FGameplayTag& Tag : Record.Tags)
+	{
+		int32& Count = AliveByTag.FindOrAdd(Tag);
+		Count += Delta;
+		if (Count <= 0)
+		{
+			AliveByTag.Remove(Tag);
+		}
+	}
+}
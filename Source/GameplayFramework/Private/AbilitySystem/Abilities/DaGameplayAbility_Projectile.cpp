@@ -6,6 +6,8 @@
 #include "CoreGameplayTags.h"
 #include "DaCharacterInterface.h"
 #include "DaProjectile.h"
+#include "DaProjectilePoolSubsystem.h"
+#include "DaProjectileSimulationSubsystem.h"
 #include "GameplayFramework.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Abilities/Tasks/AbilityTask_SpawnActor.h"
@@ -29,6 +31,19 @@ UDaGameplayAbility_Projectile::UDaGameplayAbility_Projectile(
 	HitType = ETargetLocationHitType::MouseCursor;
 }
 
+void UDaGameplayAbility_Projectile::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
+{
+	Super::OnGiveAbility(ActorInfo, Spec);
+
+	if (PoolPrewarmCount > 0 && ActorInfo && ActorInfo->IsNetAuthority() && ProjectileClass && ProjectileClass->IsChildOf<ADaProjectile>())
+	{
+		if (UDaProjectilePoolSubsystem* Pool = UDaProjectilePoolSubsystem::Get(ActorInfo->OwnerActor.Get()))
+		{
+			Pool->Prewarm(ProjectileClass.Get(), PoolPrewarmCount);
+		}
+	}
+}
+
 void UDaGameplayAbility_Projectile::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
                                                     const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
                                                     const FGameplayEventData* TriggerEventData)
@@ -163,13 +178,30 @@ void UDaGameplayAbility_Projectile::SpawnProjectile(const FVector& ProjectileTar
 			SpawnTransform.SetLocation(ProjectileLaunchLocation);
 			SpawnTransform.SetRotation(Rotation.Quaternion());
 
-			ADaProjectile* Projectile = GetWorld()->SpawnActorDeferred<ADaProjectile>(ProjectileClass,
-			SpawnTransform,
-			InstigatorCharacter,
-			InstigatorCharacter,
-			ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
-
-			Projectile->FinishSpawning(SpawnTransform);
+			if (bUseBatchedSimulation && ProjectileClass->IsChildOf<ADaProjectile>())
+			{
+				// Falls through to an actor when the class cannot be simulated or the subsystem is full
+				UDaProjectileSimulationSubsystem* Simulation = UDaProjectileSimulationSubsystem::Get(this);
+				if (Simulation && Simulation->LaunchProjectile(ProjectileClass.Get(), ProjectileLaunchLocation, Rotation, InstigatorCharacter))
+				{
+					return;
+				}
+			}
+
+			// Reuses a parked projectile of this class when the pool has one
+			UDaProjectilePoolSubsystem* Pool = UDaProjectilePoolSubsystem::Get(this);
+			if (Pool && ProjectileClass->IsChildOf<ADaProjectile>())
+			{
+				Pool->AcquireProjectile(ProjectileClass.Get(), SpawnTransform, InstigatorCharacter, InstigatorCharacter);
+			}
+			else
+			{
+				FActorSpawnParameters SpawnParams;
+				SpawnParams.Owner = InstigatorCharacter;
+				SpawnParams.Instigator = InstigatorCharacter;
+				SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+				GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnTransform, SpawnParams);
+			}
 		}
 	}
 }
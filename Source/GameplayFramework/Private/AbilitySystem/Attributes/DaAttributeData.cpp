@@ -5,13 +5,42 @@
 
 #include "GameplayFramework.h"
 
-FDaAttributeData UDaAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound) const
+const FDaAttributeData& UDaAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound) const
 {
-	for (const FDaAttributeData& Info : AttributeInfo)
+	static const FDaAttributeData NotFound;
+
+	const FDaAttributeData* Info = FindInfo(AttributeTag, bLogNotFound);
+	return Info ? *Info : NotFound;
+}
+
+void UDaAttributeInfo::FindAttributeInfoForTags(TConstArrayView<FGameplayTag> AttributeTags, TArray<const FDaAttributeData*>& OutInfos, bool bLogNotFound) const
+{
+	OutInfos.Reset(AttributeTags.Num());
+	for (const FGameplayTag& AttributeTag : AttributeTags)
+	{
+		OutInfos.Add(FindInfo(AttributeTag, bLogNotFound));
+	}
+}
+
+const FDaAttributeData* UDaAttributeInfo::FindInfo(const FGameplayTag& AttributeTag, bool bLogNotFound) const
+{
+	if (!bTagIndexBuilt)
+	{
+		RebuildTagIndex();
+	}
+
+	if (const int32* Index = TagToIndex.Find(AttributeTag))
 	{
-		if (Info.AttributeTag.MatchesTagExact(AttributeTag))
+		if (AttributeInfo.IsValidIndex(*Index) && AttributeInfo[*Index].AttributeTag == AttributeTag)
 		{
-			return Info;
+			return &AttributeInfo[*Index];
+		}
+
+		// AttributeInfo changed from code without a rebuild; the stale index must not point past or into the wrong entry
+		RebuildTagIndex();
+		if (const int32* RebuiltIndex = TagToIndex.Find(AttributeTag))
+		{
+			return &AttributeInfo[*RebuiltIndex];
 		}
 	}
 
@@ -20,5 +49,39 @@ FDaAttributeData UDaAttributeInfo::FindAttributeInfoForTag(const FGameplayTag& A
 		LOG_ERROR("Can't find Info struct for Attribute Tag [%s] on AttributeInfo [%s].", *AttributeTag.ToString(), *GetNameSafe(this));
 	}
 
-	return FDaAttributeData();
+	return nullptr;
+}
+
+void UDaAttributeInfo::RebuildTagIndex() const
+{
+	TagToIndex.Reset();
+	TagToIndex.Reserve(AttributeInfo.Num());
+
+	for (int32 Index = 0; Index < AttributeInfo.Num(); Index++)
+	{
+		// First entry wins, as with the linear search this replaces; invalid tags never matched
+		const FGameplayTag& Tag = AttributeInfo[Index].AttributeTag;
+		if (Tag.IsValid() && !TagToIndex.Contains(Tag))
+		{
+			TagToIndex.Add(Tag, Index);
+		}
+	}
+
+	bTagIndexBuilt = true;
+}
+
+void UDaAttributeInfo::PostLoad()
+{
+	Super::PostLoad();
+
+	RebuildTagIndex();
+}
+
+#if WITH_EDITOR
+void UDaAttributeInfo::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildTagIndex();
 }
+#endif
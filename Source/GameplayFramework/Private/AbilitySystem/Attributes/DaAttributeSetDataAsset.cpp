@@ -2,3 +2,114 @@
 
 
 #include "AbilitySystem/Attributes/DaAttributeSetDataAsset.h"
+
+#include "GameplayFramework.h"
+
+const FDaDynamicAttributeLayout& UDaAttributeSetDataAsset::GetLayout() const
+{
+	if (!bLayoutCompiled)
+	{
+		CompileLayout();
+	}
+	return Layout;
+}
+
+void UDaAttributeSetDataAsset::CompileLayout() const
+{
+	Layout = FDaDynamicAttributeLayout();
+	bLayoutCompiled = true;
+
+	TArray<int32> Slots;
+	Slots.Init(INDEX_NONE, Attributes.Num());
+	TBitArray<> Kept(false, Attributes.Num());
+	TBitArray<> Claimed(false, FDaDynamicAttributeLayout::MaxAttributes);
+	TSet<FName> Seen;
+
+	// Assigned slots first, so a definition added above an existing one cannot take its slot
+	for (int32 Index = 0; Index < Attributes.Num(); Index++)
+	{
+		const FDynamicAttributeDefinition& Definition = Attributes[Index];
+		if (Definition.AttributeName.IsNone())
+		{
+			LOG_WARNING("%s: skipping an attribute definition without a name", *GetName());
+			continue;
+		}
+
+		bool bAlreadySeen = false;
+		Seen.Add(Definition.AttributeName, &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			LOG_WARNING("%s: attribute %s is defined more than once, keeping the first", *GetName(), *Definition.AttributeName.ToString());
+			continue;
+		}
+		Kept[Index] = true;
+
+		if (Definition.Slot == INDEX_NONE)
+		{
+			continue;
+		}
+		if (Definition.Slot < 0 || Definition.Slot >= FDaDynamicAttributeLayout::MaxAttributes || Claimed[Definition.Slot])
+		{
+			// Only a hand-edited or duplicated definition gets here; anything that picked its old slot now points elsewhere
+			LOG_WARNING("%s: slot %d of attribute %s is out of range or taken, moving it. GameplayEffects using Dynamic%02d must be updated.",
+				*GetName(), Definition.Slot, *Definition.AttributeName.ToString(), Definition.Slot);
+			continue;
+		}
+		Claimed[Definition.Slot] = true;
+		Slots[Index] = Definition.Slot;
+	}
+
+	// New definitions take the lowest free slot, which for an asset without slots is its old positional layout
+	for (int32 Index = 0; Index < Attributes.Num(); Index++)
+	{
+		if (!Kept[Index] || Slots[Index] != INDEX_NONE)
+		{
+			continue;
+		}
+		const int32 FreeSlot = Claimed.Find(false);
+		if (FreeSlot == INDEX_NONE)
+		{
+			LOG_WARNING("%s: more than %d attributes, dropping %s", *GetName(), FDaDynamicAttributeLayout::MaxAttributes, *Attributes[Index].AttributeName.ToString());
+			continue;
+		}
+		Claimed[FreeSlot] = true;
+		Slots[Index] = FreeSlot;
+	}
+
+	for (int32 Index = 0; Index < Attributes.Num(); Index++)
+	{
+		const int32 Slot = Slots[Index];
+		if (Slot == INDEX_NONE)
+		{
+			continue;
+		}
+		if (Slot >= Layout.Num())
+		{
+			Layout.Names.SetNum(Slot + 1);
+			Layout.DefaultValues.SetNumZeroed(Slot + 1);
+		}
+		Layout.IndexByName.Add(Attributes[Index].AttributeName, Slot);
+		Layout.Names[Slot] = Attributes[Index].AttributeName;
+		Layout.DefaultValues[Slot] = Attributes[Index].DefaultValue;
+	}
+}
+
+#if WITH_EDITOR
+void UDaAttributeSetDataAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Sets already initialized keep the layout they were built with
+	CompileLayout();
+
+	// Save the slots back so they hold through any later reorder
+	for (int32 Index = 0; Index < Attributes.Num(); Index++)
+	{
+		// Only the first of a duplicated name owns its slot
+		FDynamicAttributeDefinition& Definition = Attributes[Index];
+		const int32 Slot = Layout.FindIndex(Definition.AttributeName);
+		const bool bFirst = Attributes.IndexOfByPredicate([&](const FDynamicAttributeDefinition& Other) { return Other.AttributeName == Definition.AttributeName; }) == Index;
+		Definition.Slot = bFirst ? Slot : INDEX_NONE;
+	}
+}
+#endif
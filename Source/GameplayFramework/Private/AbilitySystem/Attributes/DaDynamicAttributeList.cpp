@@ -0,0 +1,21 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "AbilitySystem/Attributes/DaDynamicAttributeList.h"
+
+#include "AbilitySystem/Attributes/DaDynamicAttributeSet.h"
+
+void FDaDynamicAttributeEntry::PostReplicatedAdd(const FDaDynamicAttributeList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerSet)
+	{
+		InArraySerializer.OwnerSet->HandleReplicatedEntry(*this);
+	}
+}
+
+void FDaDynamicAttributeEntry::PostReplicatedChange(const FDaDynamicAttributeList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerSet)
+	{
+		InArraySerializer.OwnerSet->HandleReplicatedEntry(*this);
+	}
+}
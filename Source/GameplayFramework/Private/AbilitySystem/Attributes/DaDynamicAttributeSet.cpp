@@ -3,33 +3,192 @@
 
 #include "AbilitySystem/Attributes/DaDynamicAttributeSet.h"
 
+#include "AbilitySystemComponent.h"
 #include "AbilitySystem/Attributes/DaAttributeSetDataAsset.h"
+#include "Net/UnrealNetwork.h"
+
+namespace
+{
+	/** DynamicNN properties by slot, looked up once. */
+	const TArray<FProperty*>& GetSlotProperties()
+	{
+		static const TArray<FProperty*> SlotProperties = []
+		{
+			TArray<FProperty*> Properties;
+			for (int32 Index = 0; Index < FDaDynamicAttributeLayout::MaxAttributes; Index++)
+			{
+				Properties.Add(FindFieldChecked<FProperty>(UDaDynamicAttributeSet::StaticClass(), FName(*FString::Printf(TEXT("Dynamic%02d"), Index))));
+			}
+			return Properties;
+		}();
+		return SlotProperties;
+	}
+}
+
+UDaDynamicAttributeSet::UDaDynamicAttributeSet()
+{
+	ReplicatedValues.OwnerSet = this;
+}
+
+void UDaDynamicAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UDaDynamicAttributeSet, Definition);
+	DOREPLIFETIME(UDaDynamicAttributeSet, ReplicatedValues);
+}
+
+void UDaDynamicAttributeSet::InitializeAttributes(const UDaAttributeSetDataAsset* DataAsset)
+{
+	if (!DataAsset) return;
+
+	const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	ensureMsgf(ASC == nullptr || ASC->GetAttributeSubobject(GetClass()) == nullptr || IsResolvedByASC(ASC),
+		TEXT("%s: %s already has a %s, GameplayEffects will only reach that one"), *GetName(), *GetNameSafe(ASC->GetOwner()), *GetClass()->GetName());
+
+	Definition = DataAsset;
+	const FDaDynamicAttributeLayout& Layout = DataAsset->GetLayout();
+
+	ReplicatedValues.Entries.Reset(Layout.Num());
+	for (int32 Index = 0; Index < Layout.Num(); Index++)
+	{
+		FGameplayAttributeData* Attribute = GetSlotData(Index);
+		Attribute->SetBaseValue(Layout.DefaultValues[Index]);
+		Attribute->SetCurrentValue(Layout.DefaultValues[Index]);
+
+		FDaDynamicAttributeEntry& Entry = ReplicatedValues.Entries.AddDefaulted_GetRef();
+		Entry.Slot = static_cast<uint8>(Index);
+		Entry.BaseValue = Layout.DefaultValues[Index];
+		Entry.CurrentValue = Layout.DefaultValues[Index];
+		ReplicatedValues.MarkItemDirty(Entry);
+	}
+	ReplicatedValues.MarkArrayDirty();
+}
+
+int32 UDaDynamicAttributeSet::FindAttributeIndex(FName AttributeName) const
+{
+	return Definition ? Definition->GetLayout().FindIndex(AttributeName) : INDEX_NONE;
+}
+
+int32 UDaDynamicAttributeSet::GetNumAttributes() const
+{
+	return Definition ? Definition->GetLayout().Num() : 0;
+}
+
+FGameplayAttribute UDaDynamicAttributeSet::GetAttributeForIndex(int32 Index)
+{
+	const TArray<FProperty*>& SlotProperties = GetSlotProperties();
+	return SlotProperties.IsValidIndex(Index) ? FGameplayAttribute(SlotProperties[Index]) : FGameplayAttribute();
+}
+
+FGameplayAttribute UDaDynamicAttributeSet::GetAttributeHandle(FName AttributeName) const
+{
+	return GetAttributeForIndex(FindAttributeIndex(AttributeName));
+}
 
 float UDaDynamicAttributeSet::GetAttributeValue(FName AttributeName) const
 {
-	if (const FGameplayAttributeData* Attribute = DynamicAttributes.Find(AttributeName))
+	return GetAttributeValueByIndex(FindAttributeIndex(AttributeName));
+}
+
+void UDaDynamicAttributeSet::SetAttributeValue(FName AttributeName, float NewValue)
+{
+	SetAttributeValueByIndex(FindAttributeIndex(AttributeName), NewValue);
+}
+
+float UDaDynamicAttributeSet::GetAttributeValueByIndex(int32 Index) const
+{
+	if (const FGameplayAttributeData* Attribute = GetSlotData(Index))
 	{
 		return Attribute->GetCurrentValue();
 	}
 	return 0.0f; 
 }
 
-void UDaDynamicAttributeSet::SetAttributeValue(FName AttributeName, float NewValue)
+void UDaDynamicAttributeSet::SetAttributeValueByIndex(int32 Index, float NewValue)
 {
-	if (FGameplayAttributeData* Attribute = DynamicAttributes.Find(AttributeName))
+	FGameplayAttributeData* Attribute = GetSlotData(Index);
+	if (Attribute == nullptr) return;
+
+	UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (ASC && IsResolvedByASC(ASC))
+	{
+		// Through the ASC so active modifiers stay applied on top and change delegates fire
+		ASC->SetNumericAttributeBase(GetAttributeForIndex(Index), NewValue);
+	}
+	else
 	{
+		Attribute->SetBaseValue(NewValue);
 		Attribute->SetCurrentValue(NewValue);
+		UpdateReplicatedEntry(Index);
 	}
 }
 
-void UDaDynamicAttributeSet::InitializeAttributes(UDaAttributeSetDataAsset* DataAsset)
+void UDaDynamicAttributeSet::PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue)
 {
-	if (!DataAsset) return;
+	Super::PostAttributeChange(Attribute, OldValue, NewValue);
+
+	// Base value changes end here too: the ASC recomputes the current value after every base change
+	const int32 Index = GetSlotProperties().IndexOfByKey(Attribute.GetUProperty());
+	if (Index != INDEX_NONE)
+	{
+		UpdateReplicatedEntry(Index);
+	}
+}
+
+void UDaDynamicAttributeSet::HandleReplicatedEntry(const FDaDynamicAttributeEntry& Entry)
+{
+	FGameplayAttributeData* Attribute = GetSlotData(Entry.Slot);
+	if (Attribute == nullptr) return;
+
+	const FGameplayAttributeData OldValue = *Attribute;
+	Attribute->SetBaseValue(Entry.BaseValue);
+	Attribute->SetCurrentValue(Entry.CurrentValue);
+
+	// What GAMEPLAYATTRIBUTE_REPNOTIFY does for a hand-written attribute
+	UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (ASC && IsResolvedByASC(ASC))
+	{
+		ASC->SetBaseAttributeValueFromReplication(GetAttributeForIndex(Entry.Slot), *Attribute, OldValue);
+	}
+}
+
+void UDaDynamicAttributeSet::UpdateReplicatedEntry(int32 Index)
+{
+	// Clients only mirror the server; predicted changes are corrected by the next delta
+	const AActor* OwningActor = GetOwningActor();
+	if (OwningActor == nullptr || !OwningActor->HasAuthority() || !ReplicatedValues.Entries.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	const FGameplayAttributeData* Attribute = GetSlotData(Index);
+	FDaDynamicAttributeEntry& Entry = ReplicatedValues.Entries[Index];
+	if (Entry.BaseValue != Attribute->GetBaseValue() || Entry.CurrentValue != Attribute->GetCurrentValue())
+	{
+		Entry.BaseValue = Attribute->GetBaseValue();
+		Entry.CurrentValue = Attribute->GetCurrentValue();
+		ReplicatedValues.MarkItemDirty(Entry);
+	}
+}
+
+FGameplayAttributeData* UDaDynamicAttributeSet::GetSlotData(int32 Index)
+{
+	return const_cast<FGameplayAttributeData*>(static_cast<const UDaDynamicAttributeSet*>(this)->GetSlotData(Index));
+}
 
-	for (const FDynamicAttributeDefinition& Definition : DataAsset->Attributes)
+const FGameplayAttributeData* UDaDynamicAttributeSet::GetSlotData(int32 Index) const
+{
+	const TArray<FProperty*>& SlotProperties = GetSlotProperties();
+	if (!SlotProperties.IsValidIndex(Index))
 	{
-		FGameplayAttributeData& Attribute = DynamicAttributes.FindOrAdd(Definition.AttributeName);
-		Attribute.SetBaseValue(Definition.DefaultValue);
-		Attribute.SetCurrentValue(Definition.DefaultValue);
+		return nullptr;
 	}
+	return SlotProperties[Index]->ContainerPtrToValuePtr<FGameplayAttributeData>(this);
+}
+
+bool UDaDynamicAttributeSet::IsResolvedByASC(const UAbilitySystemComponent* ASC) const
+{
+	// Through the ASC a second set would write to the first one's slot
+	return ASC->GetAttributeSubobject(GetClass()) == this;
 }
@@ -7,17 +7,33 @@
 #include "AbilitySystem/DaAbilitySet.h"
 #include "DaPawnData.h"
 #include "AbilitySystem/Attributes/DaBaseAttributeSet.h"
+#include "GameplayFramework.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+#include "AbilitySystem/Abilities/DaGameplayAbilityBase.h"
+#include "AbilitySystem/Attributes/DaCombatAttributeSet.h"
+#include "AbilitySystem/Effects/DaGameplayEffect_ConditionWorn.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#endif
+
+static TAutoConsoleVariable<float> CVarEffectNotifyBatchWindow(TEXT("da.EffectNotifyBatchWindow"), 0.0f, TEXT("Seconds effect-applied notifications are gathered before one RPC carries them to the owning client (0 = once per frame)"), ECVF_Default);
+static TAutoConsoleVariable<int32> CVarEffectNotifyMaxBatch(TEXT("da.EffectNotifyMaxBatch"), 32, TEXT("Distinct effect asset tag sets per effect-applied batch; a full batch is sent right away"), ECVF_Default);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Notify RPCs Sent"), STAT_DaEffectNotifyRPCsSent, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Effect Notify RPCs Saved"), STAT_DaEffectNotifyRPCsSaved, STATGROUP_DAGF);
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarValidateAbilityInputIndex(TEXT("da.ValidateAbilityInputIndex"), false, TEXT("Check the input tag to ability spec index against a full scan of the activatable abilities on every input event"), ECVF_Cheat);
+#endif
 
 void UDaAbilitySystemComponent::InitAbilitiesWithPawnData(const UDaPawnData* DataAsset)
 {
 	if (DataAsset && GetOwner()->HasAuthority())
 	{
-		TArray<TObjectPtr<UDaAbilitySet>> AbilitySets = DataAsset->AbilitySets;
-		for (auto AbilitySet : AbilitySets)
+		for (const UDaAbilitySet* AbilitySet : DataAsset->AbilitySets)
 		{
-			FDaAbilitySet_GrantedHandles Handle = FDaAbilitySet_GrantedHandles();
-			OutGrantedAbilityHandlesArray.Add(Handle);
-			AbilitySet->GiveToAbilitySystem(this, &Handle);
+			GrantSet(AbilitySet);
 		}
 	}
 }
@@ -26,19 +42,58 @@ void UDaAbilitySystemComponent::GrantSet(const UDaAbilitySet* AbilitySet)
 {
 	if (AbilitySet && GetOwner()->HasAuthority())
 	{
-		FDaAbilitySet_GrantedHandles Handle = FDaAbilitySet_GrantedHandles();
-		OutGrantedAbilityHandlesArray.Add(Handle);
-		AbilitySet->GiveToAbilitySystem(this, &Handle);
+		FDaGrantedAbilitySet& Granted = GrantedAbilitySets.FindOrAdd(AbilitySet);
+		if (Granted.GrantCount++ > 0)
+		{
+			return;
+		}
+
+		// Granting can re-enter GrantSet (abilities granting sets on give) and move the map's storage,
+		// so fill a local and write the handles back once the set is fully granted
+		FDaAbilitySet_GrantedHandles Handles;
+		AbilitySet->GiveToAbilitySystem(this, &Handles);
+
+		if (FDaGrantedAbilitySet* Entry = GrantedAbilitySets.Find(AbilitySet))
+		{
+			Entry->Handles = MoveTemp(Handles);
+		}
+		else
+		{
+			// Revoked again while granting, take back what was just given
+			Handles.TakeFromAbilitySystem(this);
+		}
+	}
+}
+
+void UDaAbilitySystemComponent::RevokeSet(const UDaAbilitySet* AbilitySet)
+{
+	if (AbilitySet == nullptr || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	FDaGrantedAbilitySet* Granted = GrantedAbilitySets.Find(AbilitySet);
+	if (Granted == nullptr || --Granted->GrantCount > 0)
+	{
+		return;
 	}
+
+	FDaAbilitySet_GrantedHandles Handles = MoveTemp(Granted->Handles);
+	GrantedAbilitySets.Remove(AbilitySet);
+	Handles.TakeFromAbilitySystem(this);
 }
 
 void UDaAbilitySystemComponent::ClearAbilitySets()
 {
 	if (GetOwner()->HasAuthority())
 	{
-		for (auto AbilitySetHandle: OutGrantedAbilityHandlesArray)
+		// Detach first: taking abilities away can run ability code that grants or revokes sets
+		TMap<TObjectPtr<const UDaAbilitySet>, FDaGrantedAbilitySet> ToClear = MoveTemp(GrantedAbilitySets);
+		GrantedAbilitySets.Reset();
+
+		for (TPair<TObjectPtr<const UDaAbilitySet>, FDaGrantedAbilitySet>& Pair : ToClear)
 		{
-			AbilitySetHandle.TakeFromAbilitySystem(this);
+			Pair.Value.Handles.TakeFromAbilitySystem(this);
 		}
 	}
 }
@@ -47,20 +102,27 @@ void UDaAbilitySystemComponent::AbilityInputTagPressed(const FInputActionValue&
 {
 	if (!InputTag.IsValid()) return;
 
+#if !UE_BUILD_SHIPPING
+	ValidateInputTagIndex(InputTag);
+#endif
+
+	FInputTagSpecList Specs;
+	GetSpecsForInputTag(InputTag, Specs);
+
 	ABILITYLIST_SCOPE_LOCK();
-	for (auto& AbilitySpec: GetActivatableAbilities())
+	for (const FInputTagSpec& Entry : Specs)
 	{
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		if (FGameplayAbilitySpec* AbilitySpec = FindIndexedSpec(Entry))
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (AbilitySpec.IsActive())
+			AbilitySpecInputPressed(*AbilitySpec);
+			if (AbilitySpec->IsActive())
 			{
 				FPredictionKey Key;
-				if(UGameplayAbility* Instance = AbilitySpec.GetPrimaryInstance())
+				if(UGameplayAbility* Instance = AbilitySpec->GetPrimaryInstance())
 				{
 					Key = Instance->GetCurrentActivationInfo().GetActivationPredictionKey();
 				}
-				InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, AbilitySpec.Handle, Key);
+				InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, AbilitySpec->Handle, Key);
 			}
 		}
 	}
@@ -70,15 +132,22 @@ void UDaAbilitySystemComponent::AbilityInputTagHeld(const FGameplayTag InputTag)
 {
 	if (!InputTag.IsValid()) return;
 
+#if !UE_BUILD_SHIPPING
+	ValidateInputTagIndex(InputTag);
+#endif
+
+	FInputTagSpecList Specs;
+	GetSpecsForInputTag(InputTag, Specs);
+
 	ABILITYLIST_SCOPE_LOCK();
-	for (auto& AbilitySpec: GetActivatableAbilities())
+	for (const FInputTagSpec& Entry : Specs)
 	{
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		if (FGameplayAbilitySpec* AbilitySpec = FindIndexedSpec(Entry))
 		{
-			AbilitySpecInputPressed(AbilitySpec);
-			if (!AbilitySpec.IsActive())
+			AbilitySpecInputPressed(*AbilitySpec);
+			if (!AbilitySpec->IsActive())
 			{
-				TryActivateAbility(AbilitySpec.Handle);
+				TryActivateAbility(AbilitySpec->Handle);
 			}
 		}
 	}
@@ -88,26 +157,209 @@ void UDaAbilitySystemComponent::AbilityInputTagReleased(const FGameplayTag Input
 {
 	if (!InputTag.IsValid()) return;
 
+#if !UE_BUILD_SHIPPING
+	ValidateInputTagIndex(InputTag);
+#endif
+
+	FInputTagSpecList Specs;
+	GetSpecsForInputTag(InputTag, Specs);
+
 	ABILITYLIST_SCOPE_LOCK();
-	for (auto& AbilitySpec: GetActivatableAbilities())
+	for (const FInputTagSpec& Entry : Specs)
 	{
-		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag)  && AbilitySpec.IsActive())
+		FGameplayAbilitySpec* AbilitySpec = FindIndexedSpec(Entry);
+		if (AbilitySpec && AbilitySpec->IsActive())
 		{
-			AbilitySpecInputReleased(AbilitySpec);
+			AbilitySpecInputReleased(*AbilitySpec);
 
 			FPredictionKey Key;
-			if(UGameplayAbility* Instance = AbilitySpec.GetPrimaryInstance())
+			if(UGameplayAbility* Instance = AbilitySpec->GetPrimaryInstance())
 			{
 				Key = Instance->GetCurrentActivationInfo().GetActivationPredictionKey();
 			}
-			InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputReleased, AbilitySpec.Handle, Key);
+			InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputReleased, AbilitySpec->Handle, Key);
+		}
+	}
+}
+
+void UDaAbilitySystemComponent::RefreshAbilityInputTags(FGameplayAbilitySpecHandle Handle)
+{
+	UnindexAbilitySpec(Handle);
+
+	const TArray<FGameplayAbilitySpec>& Items = GetActivatableAbilities();
+	for (int32 ItemIndex = 0; ItemIndex < Items.Num(); ItemIndex++)
+	{
+		if (Items[ItemIndex].Handle == Handle)
+		{
+			IndexAbilitySpec(Items[ItemIndex], ItemIndex);
+			break;
+		}
+	}
+}
+
+void UDaAbilitySystemComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Effects applied in the last window would otherwise never reach the client
+	FlushEffectBatch();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UDaAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	// Position unknown here (the spec may still be pending add), found on first lookup
+	IndexAbilitySpec(AbilitySpec, INDEX_NONE);
+}
+
+void UDaAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	UnindexAbilitySpec(AbilitySpec.Handle);
+
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void UDaAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	Super::OnRep_ActivateAbilities();
+
+	// Dynamic tags of specs that were already here may have changed with this update
+	RebuildInputTagIndex();
+}
+
+void UDaAbilitySystemComponent::IndexAbilitySpec(const FGameplayAbilitySpec& AbilitySpec, int32 ItemIndex)
+{
+	const FGameplayTagContainer& Tags = AbilitySpec.GetDynamicSpecSourceTags();
+	if (Tags.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		FInputTagSpec& Entry = InputTagToSpecs.FindOrAdd(Tag).AddDefaulted_GetRef();
+		Entry.Handle = AbilitySpec.Handle;
+		Entry.ItemIndex = ItemIndex;
+	}
+	IndexedSpecTags.Add(AbilitySpec.Handle, Tags);
+}
+
+void UDaAbilitySystemComponent::UnindexAbilitySpec(FGameplayAbilitySpecHandle Handle)
+{
+	FGameplayTagContainer Tags;
+	if (!IndexedSpecTags.RemoveAndCopyValue(Handle, Tags))
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (FInputTagSpecList* Specs = InputTagToSpecs.Find(Tag))
+		{
+			Specs->RemoveAll([Handle](const FInputTagSpec& Entry) { return Entry.Handle == Handle; });
+			if (Specs->IsEmpty())
+			{
+				InputTagToSpecs.Remove(Tag);
+			}
 		}
 	}
 }
 
+void UDaAbilitySystemComponent::RebuildInputTagIndex()
+{
+	InputTagToSpecs.Reset();
+	IndexedSpecTags.Reset();
+
+	const TArray<FGameplayAbilitySpec>& Items = GetActivatableAbilities();
+	for (int32 ItemIndex = 0; ItemIndex < Items.Num(); ItemIndex++)
+	{
+		IndexAbilitySpec(Items[ItemIndex], ItemIndex);
+	}
+}
+
+void UDaAbilitySystemComponent::GetSpecsForInputTag(const FGameplayTag& InputTag, FInputTagSpecList& OutSpecs) const
+{
+	if (const FInputTagSpecList* Specs = InputTagToSpecs.Find(InputTag))
+	{
+		OutSpecs = *Specs;
+	}
+}
+
+FGameplayAbilitySpec* UDaAbilitySystemComponent::FindIndexedSpec(const FInputTagSpec& Entry)
+{
+	// Specs move when others are removed; the cached slot is right nearly always
+	TArray<FGameplayAbilitySpec>& Items = GetActivatableAbilities();
+	if (Items.IsValidIndex(Entry.ItemIndex) && Items[Entry.ItemIndex].Handle == Entry.Handle)
+	{
+		return &Items[Entry.ItemIndex];
+	}
+
+	for (int32 ItemIndex = 0; ItemIndex < Items.Num(); ItemIndex++)
+	{
+		if (Items[ItemIndex].Handle == Entry.Handle)
+		{
+			// Remember the new slot in the index itself, the caller holds a copy
+			if (const FGameplayTagContainer* Tags = IndexedSpecTags.Find(Entry.Handle))
+			{
+				for (const FGameplayTag& Tag : *Tags)
+				{
+					for (FInputTagSpec& Indexed : InputTagToSpecs.FindChecked(Tag))
+					{
+						if (Indexed.Handle == Entry.Handle)
+						{
+							Indexed.ItemIndex = ItemIndex;
+						}
+					}
+				}
+			}
+			return &Items[ItemIndex];
+		}
+	}
+	return nullptr;
+}
+
+#if !UE_BUILD_SHIPPING
+void UDaAbilitySystemComponent::ValidateInputTagIndex(const FGameplayTag& InputTag)
+{
+	if (!CVarValidateAbilityInputIndex.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	TArray<FGameplayAbilitySpecHandle> Scanned;
+	for (const FGameplayAbilitySpec& AbilitySpec : GetActivatableAbilities())
+	{
+		if (AbilitySpec.GetDynamicSpecSourceTags().HasTagExact(InputTag))
+		{
+			Scanned.Add(AbilitySpec.Handle);
+		}
+	}
+
+	TArray<FGameplayAbilitySpecHandle> Indexed;
+	if (const FInputTagSpecList* Specs = InputTagToSpecs.Find(InputTag))
+	{
+		for (const FInputTagSpec& Entry : *Specs)
+		{
+			Indexed.Add(Entry.Handle);
+		}
+	}
+
+	const auto ByHandle = [](const FGameplayAbilitySpecHandle& A, const FGameplayAbilitySpecHandle& B) { return GetTypeHash(A) < GetTypeHash(B); };
+	Scanned.Sort(ByHandle);
+	Indexed.Sort(ByHandle);
+	if (Scanned != Indexed)
+	{
+		ensureMsgf(false, TEXT("%s: input tag index for %s has %d spec(s), a full scan finds %d. Dynamic spec source tags changed without RefreshAbilityInputTags?"),
+			*GetNameSafe(GetOwner()), *InputTag.ToString(), Indexed.Num(), Scanned.Num());
+		RebuildInputTagIndex();
+	}
+}
+#endif
+
 void UDaAbilitySystemComponent::AbilityActorInfoSet()
 {
-	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UDaAbilitySystemComponent::ClientEffectApplied);
+	OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &UDaAbilitySystemComponent::HandleEffectAppliedToSelf);
 }
 
 UDaBaseAttributeSet* UDaAbilitySystemComponent::GetAttributeSetForTag(const FGameplayTag& SetIdentifierTag) const
@@ -129,14 +381,82 @@ UDaBaseAttributeSet* UDaAbilitySystemComponent::GetAttributeSetForTag(const FGam
 	return nullptr;
 }
 
-void UDaAbilitySystemComponent::ClientEffectApplied_Implementation(UAbilitySystemComponent* AbilitySystemComponent,
-                                                                   const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle)
+void UDaAbilitySystemComponent::HandleEffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent,
+                                                           const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle)
 {
 	FGameplayTagContainer TagContainer;
 	EffectSpec.GetAllAssetTags(TagContainer);
 
-	if (TagContainer.IsValid())
-		EffectAssetTags.Broadcast(TagContainer);
+	// The client has nothing to broadcast for these, so they never needed an RPC
+	if (!TagContainer.IsValid())
+		return;
+
+	// DoTs and auras re-apply the same effect, fold those into one entry
+	if (FDaEffectAppliedBatchEntry* Entry = PendingEffectBatch.FindByPredicate([&TagContainer](const FDaEffectAppliedBatchEntry& Pending) { return Pending.AssetTags == TagContainer; }))
+	{
+		Entry->Count++;
+	}
+	else
+	{
+		FDaEffectAppliedBatchEntry& NewEntry = PendingEffectBatch.AddDefaulted_GetRef();
+		NewEntry.AssetTags = MoveTemp(TagContainer);
+		NewEntry.Count = 1;
+	}
+	PendingEffectCount++;
+
+	if (PendingEffectBatch.Num() >= FMath::Max(CVarEffectNotifyMaxBatch.GetValueOnGameThread(), 1))
+	{
+		FlushEffectBatch();
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (World && !EffectBatchTimerHandle.IsValid())
+	{
+		const float Window = CVarEffectNotifyBatchWindow.GetValueOnGameThread();
+		if (Window > 0.0f)
+		{
+			World->GetTimerManager().SetTimer(EffectBatchTimerHandle, this, &ThisClass::FlushEffectBatch, Window, false);
+		}
+		else
+		{
+			EffectBatchTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &ThisClass::FlushEffectBatch);
+		}
+	}
+}
+
+void UDaAbilitySystemComponent::FlushEffectBatch()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(EffectBatchTimerHandle);
+	}
+	EffectBatchTimerHandle.Invalidate();
+
+	if (PendingEffectBatch.IsEmpty())
+	{
+		return;
+	}
+
+	ClientEffectsApplied(PendingEffectBatch);
+
+	INC_DWORD_STAT(STAT_DaEffectNotifyRPCsSent);
+	INC_DWORD_STAT_BY(STAT_DaEffectNotifyRPCsSaved, PendingEffectCount - 1);
+
+	PendingEffectBatch.Reset();
+	PendingEffectCount = 0;
+}
+
+void UDaAbilitySystemComponent::ClientEffectsApplied_Implementation(const TArray<FDaEffectAppliedBatchEntry>& Batch)
+{
+	// Listeners still hear about every applied effect, as when each came in its own RPC
+	for (const FDaEffectAppliedBatchEntry& Entry : Batch)
+	{
+		for (int32 Index = 0; Index < Entry.Count; Index++)
+		{
+			EffectAssetTags.Broadcast(Entry.AssetTags);
+		}
+	}
 }
 
 void UDaAbilitySystemComponent::UpgradeAttribute(const FGameplayTag& AttributeTag, int32 Amount)
@@ -151,4 +471,91 @@ void UDaAbilitySystemComponent::ServerUpgradeAttribute_Implementation(const FGam
 	Payload.EventMagnitude = Amount;
 
 	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(GetAvatarActor(), AttributeTag, Payload);
-}
\ No newline at end of file
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDaAbilitySetChurnTest, "GameplayFramework.AbilitySystem.AbilitySetChurn",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDaAbilitySetChurnTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSets = 2000;
+	constexpr int32 NumRounds = 3;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	AActor* Owner = World->SpawnActor<AActor>();
+	UDaAbilitySystemComponent* ASC = NewObject<UDaAbilitySystemComponent>(Owner);
+	ASC->RegisterComponent();
+	ASC->InitAbilityActorInfo(Owner, Owner);
+
+	// The grant lists are only editable in the asset editor, fill them through reflection
+	auto GrantList = [](UDaAbilitySet* Set, const TCHAR* PropertyName)
+	{
+		return UDaAbilitySet::StaticClass()->FindPropertyByName(PropertyName)->ContainerPtrToValuePtr<void>(Set);
+	};
+
+	// Distinct transient sets, each granting an ability, an infinite effect and an attribute set
+	TArray<UDaAbilitySet*> Sets;
+	for (int32 i = 0; i < NumSets; i++)
+	{
+		UDaAbilitySet* Set = NewObject<UDaAbilitySet>(GetTransientPackage(), NAME_None, RF_Transient);
+
+		FDaAbilitySet_GameplayAbility& Ability = static_cast<TArray<FDaAbilitySet_GameplayAbility>*>(GrantList(Set, TEXT("GrantedGameplayAbilities")))->AddDefaulted_GetRef();
+		Ability.Ability = UDaGameplayAbilityBase::StaticClass();
+
+		FDaAbilitySet_GameplayEffect& Effect = static_cast<TArray<FDaAbilitySet_GameplayEffect>*>(GrantList(Set, TEXT("GrantedGameplayEffects")))->AddDefaulted_GetRef();
+		Effect.GameplayEffect = UDaGameplayEffect_ConditionWorn::StaticClass();
+
+		FDaAbilitySet_AttributeSet& Attributes = static_cast<TArray<FDaAbilitySet_AttributeSet>*>(GrantList(Set, TEXT("GrantedAttributes")))->AddDefaulted_GetRef();
+		Attributes.AttributeSet = UDaCombatAttributeSet::StaticClass();
+
+		Sets.Add(Set);
+	}
+
+	const int32 BaseSpecs = ASC->GetActivatableAbilities().Num();
+	const int32 BaseEffects = ASC->GetActiveEffects(FGameplayEffectQuery()).Num();
+	const int32 BaseAttributeSets = ASC->GetSpawnedAttributes().Num();
+
+	for (int32 Round = 0; Round < NumRounds; Round++)
+	{
+		// Every other set twice: nested grants give it once, only the matching last revoke takes it away
+		for (int32 i = 0; i < Sets.Num(); i++)
+		{
+			ASC->GrantSet(Sets[i]);
+			if (i % 2 == 0)
+			{
+				ASC->GrantSet(Sets[i]);
+			}
+		}
+
+		TestEqual(TEXT("Granted sets"), ASC->GetNumGrantedAbilitySets(), NumSets);
+		TestEqual(TEXT("Specs while granted"), ASC->GetActivatableAbilities().Num(), BaseSpecs + NumSets);
+		TestEqual(TEXT("Effects while granted"), ASC->GetActiveEffects(FGameplayEffectQuery()).Num(), BaseEffects + NumSets);
+		TestEqual(TEXT("Attribute sets while granted"), ASC->GetSpawnedAttributes().Num(), BaseAttributeSets + NumSets);
+
+		for (int32 i = 0; i < Sets.Num(); i++)
+		{
+			if (i % 2 == 0)
+			{
+				ASC->RevokeSet(Sets[i]);
+				TestTrue(TEXT("Nested grant still held"), ASC->HasAbilitySet(Sets[i]));
+			}
+			ASC->RevokeSet(Sets[i]);
+		}
+
+		TestEqual(TEXT("Granted sets after revoke"), ASC->GetNumGrantedAbilitySets(), 0);
+		TestEqual(TEXT("Specs after revoke"), ASC->GetActivatableAbilities().Num(), BaseSpecs);
+		TestEqual(TEXT("Effects after revoke"), ASC->GetActiveEffects(FGameplayEffectQuery()).Num(), BaseEffects);
+		TestEqual(TEXT("Attribute sets after revoke"), ASC->GetSpawnedAttributes().Num(), BaseAttributeSets);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -6,11 +6,14 @@
 #include "CoreGameplayTags.h"
 #include "GameplayFramework.h"
 #include "AI/DaAICharacter.h"
+#include "AI/DaBotRegistrySubsystem.h"
 #include "DaAttributeComponent.h"
 #include "DaPickupItem.h"
 
 #include "EngineUtils.h"
 #include "AbilitySystem/DaAbilitySystemComponent.h"
+#include "Algo/Sort.h"
+#include "Algo/UpperBound.h"
 #include "DaPawnData.h"
 #include "Engine/AssetManager.h"
 #include "Engine/StreamableManager.h"
@@ -21,6 +24,66 @@ static TAutoConsoleVariable<bool> CVarDebugSpawnBots(TEXT("da.DrawDebugSpawnBots
 static TAutoConsoleVariable<bool> CVarDebugSpawnItems(TEXT("da.DrawDebugSpawnItems"), false, TEXT("Draw Debug Spheres showing location where Items spawned"), ECVF_Cheat);
 
 
+void FDaAliasTable::Build(TConstArrayView<float> Weights)
+{
+	const int32 Num = Weights.Num();
+	Probability.SetNumUninitialized(Num);
+	Alias.SetNumUninitialized(Num);
+
+	double Total = 0.0;
+	for (const float Weight : Weights)
+	{
+		Total += Weight;
+	}
+	if (Num == 0 || Total <= 0.0)
+	{
+		Probability.Reset();
+		Alias.Reset();
+		return;
+	}
+
+	// Scale so the average bucket holds exactly 1, then pair each under-full bucket with an
+	// over-full one that tops it up (Vose's method)
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Num);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Scaled[i] = Weights[i] * Num / Total;
+		(Scaled[i] < 1.0 ? Small : Large).Add(i);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop();
+		const int32 More = Large.Pop();
+		Probability[Less] = static_cast<float>(Scaled[Less]);
+		Alias[Less] = More;
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		(Scaled[More] < 1.0 ? Small : Large).Add(More);
+	}
+
+	// Whatever is left is full up to rounding error
+	for (const int32 i : Large)
+	{
+		Probability[i] = 1.f;
+		Alias[i] = i;
+	}
+	for (const int32 i : Small)
+	{
+		Probability[i] = 1.f;
+		Alias[i] = i;
+	}
+}
+
+int32 FDaAliasTable::Sample(const FRandomStream& Stream) const
+{
+	check(!IsEmpty());
+	const int32 Bucket = Stream.RandHelper(Probability.Num());
+	return Stream.FRand() < Probability[Bucket] ? Bucket : Alias[Bucket];
+}
+
 void UDaActorSpawnManager::StartSpawning(FString LevelName)
 {
 	// Store for later use.
@@ -45,6 +108,9 @@ void UDaAISpawnManager::StartSpawning(FString LevelName)
 		return;
 	}
 
+	SelectionStream.Initialize(SelectionSeed != 0 ? SelectionSeed : FMath::Rand());
+	CurrentWave = INDEX_NONE;
+
 	// Continuous timer to spawn in more bots.
 	// Actual amount of bots and whether its allowed to spawn determined by spawn logic later in the chain...
 	GetWorld()->GetTimerManager().SetTimer(TimerHandle_SpawnBots, this, &UDaAISpawnManager::SpawnBotTimerElapsed, SpawnTimerInterval, true);
@@ -58,15 +124,8 @@ void UDaAISpawnManager::SpawnBotTimerElapsed()
 		return;
 	}
 	
-	int32 NumberOfAliveBots = 0;
-	for(ADaAICharacter* Bot : TActorRange<ADaAICharacter>(GetWorld()))
-	{
-		UDaAttributeComponent* AttribComp = UDaAttributeComponent::FindAttributeComponent(Bot);
-		if (ensure(AttribComp) && !AttribComp->IsDeadOrDying())
-		{
-			NumberOfAliveBots++;
-		}
-	}
+	const UDaBotRegistrySubsystem* Registry = UDaBotRegistrySubsystem::Get(this);
+	const int32 NumberOfAliveBots = Registry ? Registry->GetAliveCount() : 0;
 
 	LOG("Found %i alive bots", NumberOfAliveBots);
 	
@@ -82,6 +141,15 @@ void UDaAISpawnManager::SpawnBotTimerElapsed()
 		return;
 	}
 
+	// No point running the spawn query if the wave cannot afford even the cheapest monster
+	EnsureSelectionTables();
+	UpdateWaveBudget();
+	if (WaveBudgetRemaining >= 0.f && (CachedRows.Num() == 0 || CachedRows[0].SpawnCost > WaveBudgetRemaining))
+	{
+		LOG("Wave %i budget exhausted (%.1f left). Skipping spawn", CurrentWave, WaveBudgetRemaining);
+		return;
+	}
+
 	FEnvQueryRequest Request(SpawnQuery, this);
 	Request.Execute(EEnvQueryRunMode::RandomBest5Pct, this, &UDaAISpawnManager::OnSpawnQueryCompleted);
 }
@@ -103,12 +171,16 @@ void UDaAISpawnManager::OnSpawnQueryCompleted(TSharedPtr<FEnvQueryResult> Result
 	{
 		//LogOnScreen(this, "Begin Loading", FColor::Yellow);
 
-		TArray<FMonsterInfoRow*> Rows;
-		MonsterTable->GetAllRows("", Rows);
-
-		//Get Random Enemy
-		int32 RandomIndex = FMath::RandRange(0, Rows.Num() - 1);
-		FMonsterInfoRow* SelectedRow = Rows[RandomIndex];
+		const int32 SelectedIndex = SelectMonsterRow();
+		if (SelectedIndex == INDEX_NONE)
+		{
+			return;
+		}
+		const FMonsterInfoRow* SelectedRow = &CachedRows[SelectedIndex];
+		if (WaveBudgetRemaining >= 0.f)
+		{
+			WaveBudgetRemaining -= SelectedRow->SpawnCost;
+		}
 
 		UAssetManager& AssMan = UAssetManager::Get();
 
@@ -124,8 +196,15 @@ void UDaAISpawnManager::OnMonsterLoaded(FPrimaryAssetId LoadedId, FVector SpawnL
 
 	if (const UDaPawnData* PawnData = Cast<UDaPawnData>(AssMan.GetPrimaryAssetObject(LoadedId)))
 	{
-		if (const AActor* Monster = GetWorld()->SpawnActor<AActor>(PawnData->PawnClass, SpawnLocation, FRotator::ZeroRotator))
+		if (AActor* Monster = GetWorld()->SpawnActor<AActor>(PawnData->PawnClass, SpawnLocation, FRotator::ZeroRotator))
 		{
+			// Bots register themselves in BeginPlay; only the spawner knows which row they came from
+			UDaBotRegistrySubsystem* Registry = UDaBotRegistrySubsystem::Get(this);
+			if (ADaAICharacter* Bot = Cast<ADaAICharacter>(Monster); Bot && Registry)
+			{
+				Registry->SetBotMonsterId(Bot, LoadedId);
+			}
+
 			//LogOnScreen(this, FString::Printf(TEXT("Spawned Enemy: %s (%s)"), *GetNameSafe(Monster), *GetNameSafe(PawnData)));
 
 			UDaAbilitySystemComponent* ASC = Monster->FindComponentByClass<UDaAbilitySystemComponent>();
@@ -139,9 +218,154 @@ void UDaAISpawnManager::OnMonsterLoaded(FPrimaryAssetId LoadedId, FVector SpawnL
 	}
 }
 
+void UDaAISpawnManager::SetMonsterTable(UDataTable* NewMonsterTable)
+{
+	MonsterTable = NewMonsterTable;
+	bSelectionTablesDirty = true;
+}
+
+void UDaAISpawnManager::SetSelectionSeed(int32 NewSeed)
+{
+	SelectionSeed = NewSeed;
+	SelectionStream.Initialize(NewSeed);
+}
+
+void UDaAISpawnManager::HandleMonsterTableChanged()
+{
+	bSelectionTablesDirty = true;
+}
+
+void UDaAISpawnManager::EnsureSelectionTables()
+{
+	if (!bSelectionTablesDirty && CachedMonsterTable.Get() == MonsterTable)
+	{
+		return;
+	}
+
+	// Follow edits and reimports of the table we are reading
+	if (UDataTable* OldTable = CachedMonsterTable.Get())
+	{
+		OldTable->OnDataTableChanged().Remove(MonsterTableChangedHandle);
+	}
+	MonsterTableChangedHandle.Reset();
+	if (MonsterTable)
+	{
+		MonsterTableChangedHandle = MonsterTable->OnDataTableChanged().AddUObject(this, &UDaAISpawnManager::HandleMonsterTableChanged);
+	}
+	CachedMonsterTable = MonsterTable;
+	bSelectionTablesDirty = false;
+
+	CachedRows.Reset();
+	AffordableTables.Reset();
+	AffordableTableMaxCost.Reset();
+	AffordableTableRows.Reset();
+	if (!MonsterTable)
+	{
+		return;
+	}
+
+	TArray<FMonsterInfoRow*> Rows;
+	MonsterTable->GetAllRows(TEXT("UDaAISpawnManager"), Rows);
+	CachedRows.Reserve(Rows.Num());
+	for (const FMonsterInfoRow* Row : Rows)
+	{
+		if (Row)
+		{
+			CachedRows.Add(*Row);
+		}
+	}
+
+	// Stable, so equal-cost rows keep table order and a seed reproduces across rebuilds
+	Algo::StableSortBy(CachedRows, &FMonsterInfoRow::SpawnCost);
+
+	// One alias table per distinct cost: a budget of B can afford exactly the rows up to the last
+	// one costing <= B, so a binary search on cost picks the table and the draw stays O(1)
+	for (int32 End = 0; End < CachedRows.Num(); )
+	{
+		const float Cost = CachedRows[End].SpawnCost;
+		while (End < CachedRows.Num() && CachedRows[End].SpawnCost == Cost)
+		{
+			++End;
+		}
+
+		TArray<int32> RowIndices;
+		TArray<float> Weights;
+		for (int32 i = 0; i < End; ++i)
+		{
+			if (CachedRows[i].Weight > 0.f)
+			{
+				RowIndices.Add(i);
+				Weights.Add(CachedRows[i].Weight);
+			}
+		}
+
+		FDaAliasTable& Table = AffordableTables.AddDefaulted_GetRef();
+		Table.Build(Weights);
+		AffordableTableMaxCost.Add(Cost);
+		AffordableTableRows.Add(MoveTemp(RowIndices));
+	}
+}
+
+void UDaAISpawnManager::UpdateWaveBudget()
+{
+	if (!WaveBudgetCurve)
+	{
+		WaveBudgetRemaining = -1.f;
+		return;
+	}
+
+	const int32 Wave = FMath::FloorToInt32(GetWorld()->TimeSeconds / FMath::Max(WaveDuration, 1.f));
+	if (Wave != CurrentWave)
+	{
+		CurrentWave = Wave;
+		WaveBudgetRemaining = FMath::Max(0.f, WaveBudgetCurve->GetFloatValue(static_cast<float>(Wave)));
+	}
+}
+
+int32 UDaAISpawnManager::SelectMonsterRow()
+{
+	EnsureSelectionTables();
+	UpdateWaveBudget();
+	if (CachedRows.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Rows are sorted by cost, so the affordable ones are a prefix
+	int32 Affordable = CachedRows.Num();
+	if (WaveBudgetRemaining >= 0.f)
+	{
+		Affordable = Algo::UpperBoundBy(CachedRows, WaveBudgetRemaining, &FMonsterInfoRow::SpawnCost);
+		if (Affordable == 0)
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	if (SelectionMode == EDaMonsterSelectionMode::Uniform)
+	{
+		return SelectionStream.RandHelper(Affordable);
+	}
+
+	const int32 TableIndex = Algo::UpperBound(AffordableTableMaxCost, CachedRows[Affordable - 1].SpawnCost) - 1;
+	if (!AffordableTables.IsValidIndex(TableIndex) || AffordableTables[TableIndex].IsEmpty())
+	{
+		LOG_WARNING("UDaAISpawnManager: no affordable monster with Weight > 0 in %s", *GetNameSafe(MonsterTable));
+		return INDEX_NONE;
+	}
+	return AffordableTableRows[TableIndex][AffordableTables[TableIndex].Sample(SelectionStream)];
+}
+
 void UDaAISpawnManager::KillAllBots()
 {
-	for(const ADaAICharacter* Bot : TActorRange<ADaAICharacter>(GetWorld()))
+	UDaBotRegistrySubsystem* Registry = UDaBotRegistrySubsystem::Get(this);
+	if (!Registry)
+	{
+		return;
+	}
+
+	// A snapshot: every kill moves its bot out of the alive list
+	for (const ADaAICharacter* Bot : Registry->GetAliveBots())
 	{
 		UDaAttributeComponent* AttribComp = UDaAttributeComponent::FindAttributeComponent(Bot);
 		if (ensure(AttribComp) && !AttribComp->IsDeadOrDying())
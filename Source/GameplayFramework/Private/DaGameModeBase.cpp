@@ -120,7 +120,7 @@ void ADaGameModeBase::OnActorKilled(AActor* VictimActor, AActor* KillerActor)
 			PS->UpdatePersonalRecord(GetWorld()->TimeSeconds);
 		}
 		
-		// AutoSave on Player Death
+		// AutoSave on Player Death. Only the snapshot runs here, the disk write goes to a worker (da.AsyncSaveGame)
 		WriteSaveGame();
 	}
 }
@@ -0,0 +1,377 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "DaInteractableRegistrySubsystem.h"
+
+#include "DaInteractableInterface.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameplayFramework.h"
+
+static TAutoConsoleVariable<float> CVarInteractableGridCellSize(TEXT("da.InteractableGridCellSize"), 500.0f, TEXT("Cell size of the interactable registry grid, read when a world starts"), ECVF_Default);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Interactables Registered"), STAT_DaInteractablesRegistered, STATGROUP_DAGF);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interactable Queries"), STAT_DaInteractableQueries, STATGROUP_DAGF);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interactable Candidates"), STAT_DaInteractableCandidates, STATGROUP_DAGF);
+
+UDaInteractableRegistrySubsystem* UDaInteractableRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	return World ? World->GetSubsystem<UDaInteractableRegistrySubsystem>() : nullptr;
+}
+
+void UDaInteractableRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = FMath::Max(CVarInteractableGridCellSize.GetValueOnGameThread(), 50.0f);
+
+	if (UWorld* World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+		ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &ThisClass::HandleActorDestroyed));
+	}
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+}
+
+void UDaInteractableRegistrySubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	for (const FInteractableRecord& Record : Records)
+	{
+		if (const AActor* Actor = Record.Actor.Get())
+		{
+			if (USceneComponent* Root = Actor->GetRootComponent())
+			{
+				Root->TransformUpdated.RemoveAll(this);
+			}
+		}
+	}
+
+	OnInteractablesChanged.Clear();
+	Records.Empty();
+	PendingSpawns.Empty();
+	IndexByActor.Empty();
+	Cells.Empty();
+	MaxRecordRadius = 0.0f;
+	SET_DWORD_STAT(STAT_DaInteractablesRegistered, 0);
+
+	Super::Deinitialize();
+}
+
+void UDaInteractableRegistrySubsystem::RegisterActor(AActor* Actor)
+{
+	if (Actor == nullptr || Actor->GetWorld() != GetWorld() || Actor->GetRootComponent() == nullptr
+		|| !Actor->Implements<UDaInteractableInterface>() || IndexByActor.Contains(Actor))
+	{
+		return;
+	}
+
+	const int32 Index = Records.AddDefaulted();
+	FInteractableRecord& Record = Records[Index];
+	Record.Actor = Actor;
+	Record.Key = Actor;
+	IndexByActor.Add(Actor, Index);
+
+	RefreshBounds(Record);
+	Record.Cell = GetCell(Record.Center);
+	AddToCell(Record.Cell, Index);
+
+	// Follow the actor when it moves (dropped items, physics pickups)
+	Actor->GetRootComponent()->TransformUpdated.AddUObject(this, &ThisClass::HandleTransformUpdated);
+
+	SET_DWORD_STAT(STAT_DaInteractablesRegistered, Records.Num());
+	OnInteractablesChanged.Broadcast(Actor);
+}
+
+void UDaInteractableRegistrySubsystem::UnregisterActor(AActor* Actor)
+{
+	if (const int32* Index = IndexByActor.Find(Actor))
+	{
+		if (USceneComponent* Root = Actor ? Actor->GetRootComponent() : nullptr)
+		{
+			Root->TransformUpdated.RemoveAll(this);
+		}
+		RemoveRecordAt(*Index);
+		OnInteractablesChanged.Broadcast(Actor);
+	}
+}
+
+AActor* UDaInteractableRegistrySubsystem::FindNearestAlongSegment(const FVector& Start, const FVector& End, float Radius, const AActor* Ignore)
+{
+	FlushPendingRegistrations();
+
+	const float QueryReach = Radius + MaxRecordRadius;
+	const FIntVector MinCell = GetCell(Start.ComponentMin(End) - FVector(QueryReach));
+	const FIntVector MaxCell = GetCell(Start.ComponentMax(End) + FVector(QueryReach));
+
+	const FVector Segment = End - Start;
+	const double SegmentLengthSquared = Segment.SizeSquared();
+
+	AActor* BestActor = nullptr;
+	double BestAlong = TNumericLimits<double>::Max();
+	int32 NumCandidates = 0;
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (Cell == nullptr)
+				{
+					continue;
+				}
+
+				for (const int32 Index : *Cell)
+				{
+					const FInteractableRecord& Record = Records[Index];
+					NumCandidates++;
+
+					// Closest point of the segment to the bounds center, as a fraction along it
+					const double Along = SegmentLengthSquared > 0.0
+						? FMath::Clamp(FVector::DotProduct(Record.Center - Start, Segment) / SegmentLengthSquared, 0.0, 1.0)
+						: 0.0;
+					const float Reach = Radius + Record.Radius;
+					if (Along >= BestAlong || FVector::DistSquared(Start + Segment * Along, Record.Center) > FMath::Square(Reach))
+					{
+						continue;
+					}
+
+					// Same filter as the sweep, which only hits colliding actors
+					AActor* Actor = Record.Actor.Get();
+					if (Actor == nullptr || Actor == Ignore || Actor->IsPendingKillPending() || !Actor->GetActorEnableCollision())
+					{
+						continue;
+					}
+
+					BestActor = Actor;
+					BestAlong = Along;
+				}
+			}
+		}
+	}
+
+	INC_DWORD_STAT(STAT_DaInteractableQueries);
+	INC_DWORD_STAT_BY(STAT_DaInteractableCandidates, NumCandidates);
+
+	return BestActor;
+}
+
+void UDaInteractableRegistrySubsystem::HandleActorSpawned(AActor* Actor)
+{
+	// Deferred spawns and construction scripts are not finished yet, so bounds are read at the next query
+	if (Actor && Actor->Implements<UDaInteractableInterface>())
+	{
+		PendingSpawns.Add(Actor);
+
+		// Listeners that query now flush it in; the query is what registers it
+		OnInteractablesChanged.Broadcast(Actor);
+	}
+}
+
+void UDaInteractableRegistrySubsystem::HandleActorDestroyed(AActor* Actor)
+{
+	UnregisterActor(Actor);
+}
+
+void UDaInteractableRegistrySubsystem::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	// Before the first query the initial scan covers every visible level anyway
+	if (World == GetWorld() && bLevelsScanned)
+	{
+		RegisterLevel(Level);
+	}
+}
+
+void UDaInteractableRegistrySubsystem::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || Level == nullptr)
+	{
+		return;
+	}
+
+	// Streamed-out actors are not destroyed one by one, drop them with their level
+	for (int32 Index = Records.Num() - 1; Index >= 0; Index--)
+	{
+		AActor* Actor = Records[Index].Actor.Get();
+		if (Actor == nullptr)
+		{
+			RemoveRecordAt(Index);
+		}
+		else if (Actor->GetLevel() == Level)
+		{
+			UnregisterActor(Actor);
+		}
+	}
+}
+
+void UDaInteractableRegistrySubsystem::HandleTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	if (const int32* Index = IndexByActor.Find(Component->GetOwner()))
+	{
+		UpdateRecord(*Index);
+		OnInteractablesChanged.Broadcast(Component->GetOwner());
+	}
+}
+
+void UDaInteractableRegistrySubsystem::RegisterLevel(const ULevel* Level)
+{
+	if (Level == nullptr)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && !Actor->IsPendingKillPending())
+		{
+			RegisterActor(Actor);
+		}
+	}
+}
+
+void UDaInteractableRegistrySubsystem::FlushPendingRegistrations()
+{
+	if (!bLevelsScanned)
+	{
+		bLevelsScanned = true;
+
+		// One pass per world lifetime; spawns and streamed-in levels are picked up by the delegates from here on
+		if (const UWorld* World = GetWorld())
+		{
+			for (const ULevel* Level : World->GetLevels())
+			{
+				if (Level && (Level == World->PersistentLevel || Level->bIsVisible))
+				{
+					RegisterLevel(Level);
+				}
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<AActor>& Spawned : PendingSpawns)
+	{
+		AActor* Actor = Spawned.Get();
+		if (Actor && !Actor->IsPendingKillPending())
+		{
+			RegisterActor(Actor);
+		}
+	}
+	PendingSpawns.Reset();
+}
+
+FIntVector UDaInteractableRegistrySubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt32(Location.X / CellSize),
+		FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void UDaInteractableRegistrySubsystem::RefreshBounds(FInteractableRecord& Record)
+{
+	const AActor* Actor = Record.Actor.Get();
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	FVector Origin;
+	FVector Extent;
+	Actor->GetActorBounds(true, Origin, Extent);
+	if (Extent.IsNearlyZero())
+	{
+		// Nothing colliding yet (collision set up later, or a trigger-less actor), fall back to everything
+		Actor->GetActorBounds(false, Origin, Extent);
+	}
+
+	Record.Center = Origin;
+	Record.CenterOffset = Origin - Actor->GetActorLocation();
+	Record.Radius = Extent.Size();
+	MaxRecordRadius = FMath::Max(MaxRecordRadius, Record.Radius);
+}
+
+void UDaInteractableRegistrySubsystem::UpdateRecord(int32 Index)
+{
+	FInteractableRecord& Record = Records[Index];
+	const AActor* Actor = Record.Actor.Get();
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	Record.Center = Actor->GetActorLocation() + Record.CenterOffset;
+
+	const FIntVector NewCell = GetCell(Record.Center);
+	if (NewCell != Record.Cell)
+	{
+		RemoveFromCell(Record.Cell, Index);
+		AddToCell(NewCell, Index);
+		Record.Cell = NewCell;
+	}
+}
+
+void UDaInteractableRegistrySubsystem::AddToCell(const FIntVector& Cell, int32 Index)
+{
+	Cells.FindOrAdd(Cell).Add(Index);
+}
+
+void UDaInteractableRegistrySubsystem::RemoveFromCell(const FIntVector& Cell, int32 Index)
+{
+	if (TArray<int32>* CellIndices = Cells.Find(Cell))
+	{
+		CellIndices->RemoveSingleSwap(Index, EAllowShrinking::No);
+		if (CellIndices->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UDaInteractableRegistrySubsystem::RemoveRecordAt(int32 Index)
+{
+	RemoveFromCell(Records[Index].Cell, Index);
+	IndexByActor.Remove(Records[Index].Key);
+	const float RemovedRadius = Records[Index].Radius;
+
+	// Swap-remove, then point the moved actor's map entry and cell slot at its new index
+	const int32 LastIndex = Records.Num() - 1;
+	Records.RemoveAtSwap(Index);
+	if (Index != LastIndex)
+	{
+		const FInteractableRecord& Moved = Records[Index];
+		IndexByActor.Add(Moved.Key, Index);
+		if (TArray<int32>* CellIndices = Cells.Find(Moved.Cell))
+		{
+			const int32 Slot = CellIndices->Find(LastIndex);
+			if (Slot != INDEX_NONE)
+			{
+				(*CellIndices)[Slot] = Index;
+			}
+		}
+	}
+
+	// Every query is widened by the largest radius, so don't let a removed giant keep inflating them
+	if (RemovedRadius >= MaxRecordRadius)
+	{
+		MaxRecordRadius = 0.0f;
+		for (const FInteractableRecord& Record : Records)
+		{
+			MaxRecordRadius = FMath::Max(MaxRecordRadius, Record.Radius);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_DaInteractablesRegistered, Records.Num());
+}
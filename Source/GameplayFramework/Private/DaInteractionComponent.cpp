@@ -5,10 +5,12 @@
 
 #include "Blueprint/UserWidget.h"
 #include "DaInteractableInterface.h"
+#include "DaInteractableRegistrySubsystem.h"
 #include "GameplayFramework.h"
 #include "UI/DaWorldUserWidget.h"
 
 static TAutoConsoleVariable<bool> CVarDebugDrawInteraction(TEXT("da.InteractionDebugDraw"), false, TEXT("Enable Debug Lines For Interact Component."), ECVF_Cheat);
+static TAutoConsoleVariable<bool> CVarInteractionForceSweep(TEXT("da.InteractionForceSweep"), false, TEXT("Find interactables with the physics sweep even on components set to the spatial registry"), ECVF_Cheat);
 
 // Sets default values for this component's properties
 UDaInteractionComponent::UDaInteractionComponent()
@@ -17,6 +19,13 @@ UDaInteractionComponent::UDaInteractionComponent()
 
 	InteractionType = EInteractionType::MouseCursor;
 	HighlightType = EInteractionHighlightType::TextWidgetAndPPStencilOutline;
+	QueryMode = EInteractionQueryMode::SpatialRegistry;
+
+	UpdatePolicy = EInteractionUpdatePolicy::EveryFrame;
+	UpdateRateHz = 15.0f;
+	MovementThreshold = 10.0f;
+	RotationThreshold = 1.0f;
+	CursorMovementThreshold = 2.0f;
 		
 	TraceRadius = 30.0f;
 	TraceDistance = 500.0f;
@@ -24,27 +33,101 @@ UDaInteractionComponent::UDaInteractionComponent()
 	CollisionChannel = TRACE_INTERACT;
 }
 
+void UDaInteractionComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ApplyUpdatePolicy();
+
+	if (UDaInteractableRegistrySubsystem* Registry = UDaInteractableRegistrySubsystem::Get(this))
+	{
+		InteractablesChangedHandle = Registry->OnInteractablesChanged.AddUObject(this, &ThisClass::HandleInteractablesChanged);
+	}
+}
+
 void UDaInteractionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (UDaInteractableRegistrySubsystem* Registry = UDaInteractableRegistrySubsystem::Get(this))
+	{
+		Registry->OnInteractablesChanged.Remove(InteractablesChangedHandle);
+	}
+
 	RemoveWidget();
 	
 	Super::EndPlay(EndPlayReason);
 }
 
-void UDaInteractionComponent::RemoveWidget()
+void UDaInteractionComponent::HideWidget()
 {
 	bool bDebugDraw = CVarDebugDrawInteraction.GetValueOnGameThread();
 
-	if (DefaultWidgetInstance && DefaultWidgetInstance->IsInViewport())
+	if (DefaultWidgetInstance && DefaultWidgetInstance->IsInViewport() && DefaultWidgetInstance->GetVisibility() != ESlateVisibility::Collapsed)
 	{
-		DefaultWidgetInstance->RemoveFromParent();
+		DefaultWidgetInstance->SetVisibility(ESlateVisibility::Collapsed);
 		if (bDebugDraw)
 		{
-			LogOnScreen(this,"DaInteractionComponent: Removed Widget to Viewport.", true, FColor::Yellow);
+			LogOnScreen(this,"DaInteractionComponent: Hid Widget.", true, FColor::Yellow);
 		}
 	}
 }
 
+void UDaInteractionComponent::RemoveWidget()
+{
+	bool bDebugDraw = CVarDebugDrawInteraction.GetValueOnGameThread();
+
+	for (const TPair<TSubclassOf<UDaWorldUserWidget>, TObjectPtr<UDaWorldUserWidget>>& Pair : FocusWidgets)
+	{
+		if (Pair.Value && Pair.Value->IsInViewport())
+		{
+			Pair.Value->RemoveFromParent();
+			if (bDebugDraw)
+			{
+				LogOnScreen(this,"DaInteractionComponent: Removed Widget to Viewport.", true, FColor::Yellow);
+			}
+		}
+	}
+	FocusWidgets.Empty();
+	DefaultWidgetInstance = nullptr;
+}
+
+void UDaInteractionComponent::RequestFocusUpdate()
+{
+	if (UpdatePolicy == EInteractionUpdatePolicy::OnDemand)
+	{
+		const APawn* MyPawn = Cast<APawn>(GetOwner());
+		if (MyPawn && MyPawn->IsLocallyControlled())
+		{
+			UpdateFocus();
+		}
+		return;
+	}
+
+	bFocusUpdateRequested = true;
+}
+
+void UDaInteractionComponent::HandleInteractablesChanged(AActor* Actor)
+{
+	// The other policies re-evaluate anyway; on demand stays on demand
+	if (UpdatePolicy == EInteractionUpdatePolicy::MovementThreshold)
+	{
+		bFocusUpdateRequested = true;
+	}
+}
+
+void UDaInteractionComponent::SetUpdatePolicy(EInteractionUpdatePolicy NewPolicy)
+{
+	UpdatePolicy = NewPolicy;
+	bFocusUpdateRequested = true;
+	ApplyUpdatePolicy();
+}
+
+void UDaInteractionComponent::ApplyUpdatePolicy()
+{
+	// Fixed rate is left to the tick scheduler, on demand does not tick at all
+	SetComponentTickInterval(UpdatePolicy == EInteractionUpdatePolicy::FixedRate ? 1.0f / FMath::Max(UpdateRateHz, 1.0f) : 0.0f);
+	SetComponentTickEnabled(UpdatePolicy != EInteractionUpdatePolicy::OnDemand);
+}
+
 // Called every frame
 void UDaInteractionComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -53,15 +136,82 @@ void UDaInteractionComponent::TickComponent(float DeltaTime, ELevelTick TickType
 	APawn* MyPawn = CastChecked<APawn>(GetOwner());
 	if(MyPawn->IsLocallyControlled())
 	{
-		if (InteractionType == EInteractionType::SphereTrace)
+		if (UpdatePolicy == EInteractionUpdatePolicy::MovementThreshold && bHasUpdatedFocus && !bFocusUpdateRequested)
 		{
-			FindBestInteractable();
+			// A focused actor that went away (picked up, destroyed, hidden, made non-interactable) has to be dropped even when standing still
+			const bool bFocusLost = FocusedActor && (!IsValid(FocusedActor) || FocusedActor->IsPendingKillPending()
+				|| FocusedActor->IsHidden() || !FocusedActor->GetActorEnableCollision());
+			if (!bFocusLost && !HasViewMovedSinceUpdate())
+			{
+				return;
+			}
 		}
-		else if (InteractionType == EInteractionType::MouseCursor)
+
+		UpdateFocus();
+	}
+}
+
+void UDaInteractionComponent::UpdateFocus()
+{
+	bFocusUpdateRequested = false;
+	bHasUpdatedFocus = true;
+
+	GetFocusViewPoint(LastUpdateViewLocation, LastUpdateViewRotation);
+
+	if (InteractionType == EInteractionType::SphereTrace)
+	{
+		FindBestInteractable();
+	}
+	else if (InteractionType == EInteractionType::MouseCursor)
+	{
+		float MouseX = 0.0f;
+		float MouseY = 0.0f;
+		const APlayerController* PlayerController = CastChecked<APawn>(GetOwner())->GetController<APlayerController>();
+		if (PlayerController && PlayerController->GetMousePosition(MouseX, MouseY))
+		{
+			LastUpdateCursorPosition = FVector2D(MouseX, MouseY);
+		}
+		CursorTrace();
+	}
+}
+
+bool UDaInteractionComponent::HasViewMovedSinceUpdate() const
+{
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	GetFocusViewPoint(ViewLocation, ViewRotation);
+
+	if (FVector::DistSquared(ViewLocation, LastUpdateViewLocation) > FMath::Square(MovementThreshold)
+		|| !ViewRotation.Equals(LastUpdateViewRotation, RotationThreshold))
+	{
+		return true;
+	}
+
+	if (InteractionType == EInteractionType::MouseCursor)
+	{
+		float MouseX = 0.0f;
+		float MouseY = 0.0f;
+		const APlayerController* PlayerController = CastChecked<APawn>(GetOwner())->GetController<APlayerController>();
+		if (PlayerController && PlayerController->GetMousePosition(MouseX, MouseY))
 		{
-			CursorTrace();
+			return FVector2D::DistSquared(FVector2D(MouseX, MouseY), LastUpdateCursorPosition) > FMath::Square(CursorMovementThreshold);
 		}
 	}
+	return false;
+}
+
+void UDaInteractionComponent::GetFocusViewPoint(FVector& OutLocation, FRotator& OutRotation) const
+{
+	const APawn* MyPawn = CastChecked<APawn>(GetOwner());
+	const APlayerController* PlayerController = MyPawn->GetController<APlayerController>();
+	if (InteractionType == EInteractionType::MouseCursor && PlayerController)
+	{
+		PlayerController->GetPlayerViewPoint(OutLocation, OutRotation);
+	}
+	else
+	{
+		MyPawn->GetActorEyesViewPoint(OutLocation, OutRotation);
+	}
 }
 
 void UDaInteractionComponent::CursorTrace()
@@ -83,6 +233,12 @@ void UDaInteractionComponent::CursorTrace()
 		FocusedActor = HitActor;
 	}
 
+	// Highlight and widget already show this actor
+	if (FocusedActor == PreviousFocusedActor)
+	{
+		return;
+	}
+
 	HighlightFocusedActor(bDebugDraw);
 
 	ToggleWidgetOnFocusedActor(bDebugDraw);
@@ -91,9 +247,6 @@ void UDaInteractionComponent::CursorTrace()
 void UDaInteractionComponent::FindBestInteractable()
 {
 	bool bDebugDraw = CVarDebugDrawInteraction.GetValueOnGameThread();
-	
-	FCollisionObjectQueryParams ObjectQueryParams;
-	ObjectQueryParams.AddObjectTypesToQuery(CollisionChannel);
 
 	AActor* MyOwner = GetOwner();
 
@@ -103,47 +256,68 @@ void UDaInteractionComponent::FindBestInteractable()
 	
 	FVector End = EyeLocation + (EyeRotation.Vector() * TraceDistance);
 
+	// Clear Focused Actor before hit
+	PreviousFocusedActor = FocusedActor;
+	FocusedActor = nullptr;
+
+	UDaInteractableRegistrySubsystem* Registry = QueryMode == EInteractionQueryMode::SpatialRegistry && !CVarInteractionForceSweep.GetValueOnGameThread()
+		? UDaInteractableRegistrySubsystem::Get(this)
+		: nullptr;
+	if (Registry)
+	{
+		FocusedActor = Registry->FindNearestAlongSegment(EyeLocation, End, TraceRadius, MyOwner);
+	}
+	else
+	{
+		FocusedActor = SweepForInteractable(EyeLocation, End, bDebugDraw);
+	}
+
+	if (bDebugDraw && FocusedActor)
+	{
+		LogOnScreen(this,FString::Printf(TEXT("DaInteractionComponent: FocusedActor: %s."), *GetNameSafe(FocusedActor)), true, FColor::Yellow, 5.f, 1);
+	}
+
+	// Highlight and widget already show this actor
+	if (FocusedActor != PreviousFocusedActor)
+	{
+		HighlightFocusedActor(bDebugDraw);
+	
+		ToggleWidgetOnFocusedActor(bDebugDraw);
+	}
+	
+	if (bDebugDraw)
+	{
+		DrawDebugLine(GetWorld(), EyeLocation, End, FocusedActor ? FColor::Green : FColor::Red, false, 1.0f, 0, 2.0f);
+	}
+}
+
+AActor* UDaInteractionComponent::SweepForInteractable(const FVector& Start, const FVector& End, bool bDebugDraw) const
+{
+	FCollisionObjectQueryParams ObjectQueryParams;
+	ObjectQueryParams.AddObjectTypesToQuery(CollisionChannel);
+
 	FCollisionShape Shape;
 	Shape.SetSphere(TraceRadius);
 	
 	TArray<FHitResult> Hits;
-	bool bBlockingHit = GetWorld()->SweepMultiByObjectType(Hits, EyeLocation, End, FQuat::Identity, ObjectQueryParams, Shape);
+	bool bBlockingHit = GetWorld()->SweepMultiByObjectType(Hits, Start, End, FQuat::Identity, ObjectQueryParams, Shape);
 	
 	FColor LineColor = bBlockingHit ? FColor::Green : FColor::Red;
 
-	// Clear Focused Actor before hit
-	PreviousFocusedActor = FocusedActor;
-	FocusedActor = nullptr;
-	
-	for (FHitResult Hit : Hits)
+	for (const FHitResult& Hit : Hits)
 	{
 		if (bDebugDraw)
 		{
 			DrawDebugSphere(GetWorld(), Hit.ImpactPoint, TraceRadius, 32, LineColor, false, 1.0f);
 		}
 		
-		if (AActor* HitActor = Hit.GetActor())
+		AActor* HitActor = Hit.GetActor();
+		if (HitActor && HitActor->Implements<UDaInteractableInterface>())
 		{
-			if (HitActor->Implements<UDaInteractableInterface>())
-			{
-				FocusedActor = HitActor;
-				if (bDebugDraw)
-				{
-					LogOnScreen(this,FString::Printf(TEXT("DaInteractionComponent: FocusedActor: %s."), *GetNameSafe(FocusedActor)), true, FColor::Yellow, 5.f, 1);
-				}
-				break;
-			}
+			return HitActor;
 		}
 	}
-
-	HighlightFocusedActor(bDebugDraw);
-	
-	ToggleWidgetOnFocusedActor(bDebugDraw);
-	
-	if (bDebugDraw)
-	{
-		DrawDebugLine(GetWorld(), EyeLocation, End, LineColor, false, 1.0f, 0, 2.0f);
-	}
+	return nullptr;
 }
 
 void UDaInteractionComponent::HighlightFocusedActor(bool bDebugDraw)
@@ -183,22 +357,30 @@ void UDaInteractionComponent::ToggleWidgetOnFocusedActor(bool bDebugDraw)
 			if (WidgetClassToSpawn == nullptr)
 				WidgetClassToSpawn = DefaultWidgetClass;
 
-			if (DefaultWidgetInstance && DefaultWidgetInstance->GetClass() != WidgetClassToSpawn)
+			if (!ensure(WidgetClassToSpawn))
+			{
+				return;
+			}
+
+			// Lazily load the widget when its first needed, then keep it for every later focus
+			TObjectPtr<UDaWorldUserWidget>& Widget = FocusWidgets.FindOrAdd(WidgetClassToSpawn);
+			if (Widget == nullptr)
 			{
-				RemoveWidget();
-				DefaultWidgetInstance = nullptr;
+				Widget = CreateWidget<UDaWorldUserWidget>(GetWorld(), WidgetClassToSpawn);
 			}
-			
-			// Lazily load the widget when its first needed
-			if (DefaultWidgetInstance == nullptr && ensure(WidgetClassToSpawn))
+
+			if (DefaultWidgetInstance != Widget)
 			{
-				DefaultWidgetInstance = CreateWidget<UDaWorldUserWidget>(GetWorld(), WidgetClassToSpawn);
+				HideWidget();
+				DefaultWidgetInstance = Widget;
 			}
 
 			if (DefaultWidgetInstance)
 			{
-				DefaultWidgetInstance->AttachedActor = FocusedActor;
+				DefaultWidgetInstance->SetAttachedActor(FocusedActor);
+				DefaultWidgetInstance->SetVisibility(WidgetClassToSpawn->GetDefaultObject<UDaWorldUserWidget>()->GetVisibility());
 
+				// Only the first focus (or one after the widget removed itself) touches the viewport
 				if (!DefaultWidgetInstance->IsInViewport())
 				{
 					DefaultWidgetInstance->AddToViewport();
@@ -211,7 +393,7 @@ void UDaInteractionComponent::ToggleWidgetOnFocusedActor(bool bDebugDraw)
 		}
 		else
 		{
-			RemoveWidget();
+			HideWidget();
 		}
 	}
 }
@@ -219,6 +401,12 @@ void UDaInteractionComponent::ToggleWidgetOnFocusedActor(bool bDebugDraw)
 
 void UDaInteractionComponent::PrimaryInteract()
 {
+	// Nothing keeps focus current on demand, look before interacting
+	if (UpdatePolicy == EInteractionUpdatePolicy::OnDemand)
+	{
+		RequestFocusUpdate();
+	}
+
 	if (CVarDebugDrawInteraction.GetValueOnGameThread())
 	{
 		LogOnScreen(this,FString::Printf(TEXT("DaInteractionComponent::PrimaryInteract FocusedActor: %s."), *GetNameSafe(FocusedActor)), true, FColor::Green, 5.f, 2);
@@ -229,6 +417,12 @@ void UDaInteractionComponent::PrimaryInteract()
 
 void UDaInteractionComponent::SecondaryInteract()
 {
+	// Nothing keeps focus current on demand, look before interacting
+	if (UpdatePolicy == EInteractionUpdatePolicy::OnDemand)
+	{
+		RequestFocusUpdate();
+	}
+
 	if (CVarDebugDrawInteraction.GetValueOnGameThread())
 	{
 		LogOnScreen(this,FString::Printf(TEXT("DaInteractionComponent::SecondaryInteract FocusedActor: %s."), *GetNameSafe(FocusedActor)), true, FColor::Green, 5.f, 2);
@@ -8,12 +8,12 @@
 #include "AbilitySystem/DaAbilitySystemComponent.h"
 #include "Components/SphereComponent.h"
 #include "CoreGameplayTags.h"
-#include "Engine/AssetManager.h"
 #include "Equipment/DaConditionComponent.h"
 #include "GameplayFramework.h"
 #include "GameFramework/PlayerState.h"
 #include "Inventory/DaInventoryComponent.h"
 #include "Inventory/DaItemDefinition.h"
+#include "Inventory/DaItemDefinitionCache.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Net/UnrealNetwork.h"
 
@@ -54,13 +54,32 @@ void ADaItemActor::BeginPlay()
 		// from: it is a factory-fresh example of its type. Saying that explicitly is what stops a
 		// wear driver on the pickup from spending its whole retry budget looking for an inventory
 		// entry that does not exist, and then warning about it.
-		const UDaItemDefinition* Def = ResolveItemDefinition(ItemDefinitionID);
-		DroppedWearGrade = Def
-			? FMath::Clamp(Def->ConditionConfig.DefaultGrade / 10.f, 0.f, 1.f)
-			: 0.f;
+		DroppedWearGrade = 0.f;
 		DroppedWearSeed = 0.f;
 		DroppedWearIntensity = 0.f;
 		bHasDroppedWear = true;
+
+		// The grade only tints the wear, so a level full of pickups streams their definitions in
+		// instead of each one loading synchronously in BeginPlay; the grade is pushed when it lands.
+		if (UDaItemDefinitionCache* Cache = UDaItemDefinitionCache::Get(this))
+		{
+			TWeakObjectPtr<ADaItemActor> WeakThis = this;
+			Cache->RequestDefinition(ItemDefinitionID, FDaItemDefinitionLoaded::CreateLambda(
+				[WeakThis](UDaItemDefinition* Def)
+				{
+					ADaItemActor* Self = WeakThis.Get();
+					if (Self && Def && !Self->bHasDroppedSnapshot)
+					{
+						Self->DroppedWearGrade = FMath::Clamp(Def->ConditionConfig.DefaultGrade / 10.f, 0.f, 1.f);
+						Self->ApplyDroppedWear();
+					}
+				}));
+		}
+		else
+		{
+			LOG_WARNING("ItemActor %s: no item definition cache, %s keeps wear grade 0 instead of its default",
+				*GetNameSafe(this), *ItemDefinitionID.ToString());
+		}
 	}
 
 	// A drop sets its wear in InitializeDroppedItem, which runs before FinishSpawning when components
@@ -269,18 +288,9 @@ void ADaItemActor::ApplyDroppedWear()
 	}
 }
 
-const UDaItemDefinition* ADaItemActor::ResolveItemDefinition(const FPrimaryAssetId& InItemDefinitionID)
+const UDaItemDefinition* ADaItemActor::ResolveItemDefinition(const FPrimaryAssetId& InItemDefinitionID) const
 {
-	if (!InItemDefinitionID.IsValid())
-	{
-		return nullptr;
-	}
-	if (const UDaItemDefinition* Loaded = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(InItemDefinitionID)))
-	{
-		return Loaded;
-	}
-	const FSoftObjectPath Path = UAssetManager::Get().GetPrimaryAssetPath(InItemDefinitionID);
-	return Cast<UDaItemDefinition>(Path.TryLoad());
+	return UDaItemDefinitionCache::ResolveDefinitionBlocking(this, InItemDefinitionID);
 }
 
 void ADaItemActor::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
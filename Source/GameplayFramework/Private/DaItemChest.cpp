@@ -3,6 +3,7 @@
 
 #include "DaItemChest.h"
 
+#include "DaSaveActorRegistrySubsystem.h"
 #include "Net/UnrealNetwork.h"
 
 #define LOCTEXT_NAMESPACE "InteractableActors"
@@ -26,6 +27,8 @@ void ADaItemChest::Interact_Implementation(APawn* InstigatorPawn)
 {
 	bLidOpened = !bLidOpened;
 	OnRep_LidOpened();
+
+	UDaSaveActorRegistrySubsystem::MarkSaveDirtyFor(this);
 }
 
 void ADaItemChest::SecondaryInteract_Implementation(APawn* InstigatorPawn)
@@ -71,6 +74,12 @@ bool ADaItemChest::ShouldLoadTransform_Implementation()
 	return true;
 }
 
+bool ADaItemChest::SupportsSaveDirtyTracking_Implementation()
+{
+	// bLidOpened only changes in Interact, which marks the chest dirty
+	return true;
+}
+
 void ADaItemChest::OnRep_LidOpened()
 {
 	float CurrentPitch = bLidOpened ? TargetPitch : 0.0f;
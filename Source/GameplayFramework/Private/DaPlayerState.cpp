@@ -157,15 +157,16 @@ void ADaPlayerState::SavePlayerState_Implementation(UDaSaveGame* SaveObject)
 {
 	if (SaveObject)
 	{
-		FPlayerSaveData SaveData;
+		// Stored as FString for simplicity (original Steam ID is uint64). Overwrites this player's
+		// previous entry in place and leaves every other player's untouched.
+		const FString PlayerID = UDaSaveGame::GetPlayerSaveID(this);
+		FPlayerSaveData& SaveData = SaveObject->FindOrAddPlayerData(PlayerID);
+		SaveData = FPlayerSaveData();
+		SaveData.PlayerID = PlayerID;
 		SaveData.Credits = Credits;
 		SaveData.Level = Level;
 		SaveData.PersonalRecordTime = PersonalRecordTime;
 
-		// Stored as FString for simplicity (original Steam ID is uint64)
-		SaveData.PlayerID = GetUniqueId()->ToString();
-		//SaveData.PlayerID = GetPlayerId();
-		
 		// May not be alive while we save
 		if (APawn* MyPawn = GetPawn())
 		{
@@ -186,8 +187,6 @@ void ADaPlayerState::SavePlayerState_Implementation(UDaSaveGame* SaveObject)
 				Saved.ItemID = Pair.Value;
 			}
 		}
-
-		SaveObject->SavedPlayers.Add(SaveData);
 	}
 }
 
@@ -4,10 +4,12 @@
 #include "DaProjectile.h"
 
 #include "Components/SphereComponent.h"
+#include "DaProjectilePoolSubsystem.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "NiagaraComponent.h"
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
 #include "Sound/SoundCue.h"
 
 // Sets default values
@@ -50,6 +52,31 @@ void ADaProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Prewarmed by the pool (or replicated to a client while parked there): start out hidden
+	if (!LaunchState.bActive)
+	{
+		ResetForPool();
+		return;
+	}
+
+	StartFlight();
+}
+
+void ADaProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bAcquiredFromPool)
+	{
+		if (UDaProjectilePoolSubsystem* Pool = UDaProjectilePoolSubsystem::Get(this))
+		{
+			Pool->NotifyProjectileDestroyed(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADaProjectile::StartFlight()
+{
 	AudioComp->Play();
 
 	if (APawn* InstigatorActor = GetInstigator())
@@ -59,6 +86,108 @@ void ADaProjectile::BeginPlay()
 	}
 }
 
+void ADaProjectile::ResetForPool()
+{
+	// Also clears the life span and any detonate/teleport timers of subclasses
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	AudioComp->Stop();
+	EffectComp->DeactivateImmediate();
+
+	MovementComp->StopMovementImmediately();
+	MovementComp->Deactivate();
+
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	SphereComp->ClearMoveIgnoreActors();
+}
+
+void ADaProjectile::RestoreFromPool()
+{
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	// A blocking hit stops the simulation and drops the updated component, put both back.
+	// Launch along the new facing at InitialSpeed, as UProjectileMovementComponent does on spawn.
+	MovementComp->SetUpdatedComponent(SphereComp);
+	MovementComp->Velocity = GetActorForwardVector() * MovementComp->InitialSpeed;
+	MovementComp->Activate(true);
+	MovementComp->UpdateComponentVelocity();
+
+	EffectComp->Activate(true);
+
+	if (InitialLifeSpan > 0.0f)
+	{
+		SetLifeSpan(InitialLifeSpan);
+	}
+}
+
+void ADaProjectile::LaunchFromPool(const FTransform& SpawnTransform)
+{
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	LaunchState.Generation++;
+	LaunchState.bActive = true;
+	LaunchState.Location = SpawnTransform.GetLocation();
+	LaunchState.Rotation = SpawnTransform.Rotator();
+
+	// A reuse with the actor still parked from a previous flight needs the full reset first
+	ResetForPool();
+	RestoreFromPool();
+	StartFlight();
+}
+
+void ADaProjectile::OnRep_LaunchState()
+{
+	// The initial bunch is handled by BeginPlay
+	if (!HasActorBegunPlay())
+	{
+		return;
+	}
+
+	// Clients simulate the flight themselves (movement is not replicated), so mirror the server's pool transitions
+	ResetForPool();
+	if (LaunchState.bActive)
+	{
+		SetActorLocationAndRotation(LaunchState.Location, LaunchState.Rotation, false, nullptr, ETeleportType::ResetPhysics);
+		RestoreFromPool();
+		StartFlight();
+	}
+}
+
+void ADaProjectile::ReleaseToPool()
+{
+	if (!HasAuthority())
+	{
+		// The server owns the lifetime of replicated projectiles; hide until its release replicates
+		ResetForPool();
+		return;
+	}
+
+	if (!LaunchState.bActive)
+	{
+		return;
+	}
+
+	UDaProjectilePoolSubsystem* Pool = UDaProjectilePoolSubsystem::Get(this);
+	if (!bAllowPooling || Pool == nullptr || !Pool->ReleaseProjectile(this))
+	{
+		Destroy();
+	}
+}
+
+void ADaProjectile::LifeSpanExpired()
+{
+	ReleaseToPool();
+}
+
+void ADaProjectile::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ADaProjectile, LaunchState);
+}
+
 void ADaProjectile::OnProjectileHit(UPrimitiveComponent* HitComponent, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
@@ -71,13 +200,20 @@ void ADaProjectile::Explode_Implementation()
 	{
 		AudioComp->Stop();
 		
-		UGameplayStatics::PlaySoundAtLocation(this, HitSound, GetActorLocation());
-		UGameplayStatics::SpawnEmitterAtLocation(this, HitEffect, GetActorLocation());
-		UGameplayStatics::PlayWorldCameraShake(this, ImpactShake, GetActorLocation(), ImpactShakeInnerRadius, ImpactShakeOuterRadius);
+		PlayImpactCosmetics(this, GetActorLocation());
 
-		Destroy();
+		ReleaseToPool();
 	}
 }
 
+void ADaProjectile::PlayImpactCosmetics(const UObject* WorldContextObject, const FVector& Location) const
+{
+	UGameplayStatics::PlaySoundAtLocation(WorldContextObject, HitSound, Location);
+	UGameplayStatics::SpawnEmitterAtLocation(WorldContextObject, HitEffect, Location);
+	UGameplayStatics::PlayWorldCameraShake(WorldContextObject, ImpactShake, Location, ImpactShakeInnerRadius, ImpactShakeOuterRadius);
+}
 
-
+void ADaProjectile::HandleSimulatedImpact(const FHitResult& Hit)
+{
+	Explode();
+}
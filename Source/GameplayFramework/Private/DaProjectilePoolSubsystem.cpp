@@ -0,0 +1,222 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "DaProjectilePoolSubsystem.h"
+
+#include "DaProjectile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameplayFramework.h"
+
+static TAutoConsoleVariable<bool> CVarProjectilePooling(TEXT("da.ProjectilePooling"), true, TEXT("Recycle exploded projectiles through UDaProjectilePoolSubsystem instead of destroying them"), ECVF_Default);
+static TAutoConsoleVariable<int32> CVarProjectilePoolMaxFree(TEXT("da.ProjectilePoolMaxFree"), 64, TEXT("Parked projectiles kept per class; releases beyond this are destroyed"), ECVF_Default);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles Active"), STAT_DaProjectilesActive, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles Pooled"), STAT_DaProjectilesPooled, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectiles High Water"), STAT_DaProjectilesHighWater, STATGROUP_DAGF);
+
+UDaProjectilePoolSubsystem* UDaProjectilePoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	return World ? World->GetSubsystem<UDaProjectilePoolSubsystem>() : nullptr;
+}
+
+ADaProjectile* UDaProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<ADaProjectile> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator)
+{
+	if (Class == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (!CVarProjectilePooling.GetValueOnGameThread())
+	{
+		return SpawnProjectile(Class, SpawnTransform, Owner, Instigator, false);
+	}
+
+	FProjectilePool& Pool = Pools.FindOrAdd(Class.Get());
+
+	ADaProjectile* Projectile = nullptr;
+	while (Projectile == nullptr && Pool.Free.Num() > 0)
+	{
+		// Entries go stale when a parked projectile is destroyed from outside (level unload, editor)
+		ADaProjectile* Candidate = Pool.Free.Pop(EAllowShrinking::No).Get();
+		if (IsValid(Candidate) && !Candidate->IsPendingKillPending())
+		{
+			Projectile = Candidate;
+		}
+	}
+
+	if (Projectile)
+	{
+		// Awake before the launch state changes, so the flush sends it
+		Projectile->SetNetDormancy(DORM_Awake);
+		Projectile->SetOwner(Owner);
+		Projectile->SetInstigator(Instigator);
+		Projectile->LaunchFromPool(SpawnTransform);
+	}
+	else
+	{
+		Projectile = SpawnProjectile(Class, SpawnTransform, Owner, Instigator, false);
+		if (Projectile == nullptr)
+		{
+			return nullptr;
+		}
+	}
+
+	Projectile->bAcquiredFromPool = true;
+	Pool.NumActive++;
+	Pool.HighWaterMark = FMath::Max(Pool.HighWaterMark, Pool.NumActive);
+	TotalActive++;
+	TotalHighWaterMark = FMath::Max(TotalHighWaterMark, TotalActive);
+
+	UpdateStats();
+	return Projectile;
+}
+
+bool UDaProjectilePoolSubsystem::ReleaseProjectile(ADaProjectile* Projectile)
+{
+	if (Projectile == nullptr || !Projectile->HasAuthority())
+	{
+		return false;
+	}
+
+	FProjectilePool& Pool = Pools.FindOrAdd(Projectile->GetClass());
+	if (Projectile->bAcquiredFromPool)
+	{
+		Projectile->bAcquiredFromPool = false;
+		Pool.NumActive--;
+		TotalActive--;
+	}
+
+	const bool bPark = CVarProjectilePooling.GetValueOnGameThread() && Pool.Free.Num() < CVarProjectilePoolMaxFree.GetValueOnGameThread();
+	if (bPark)
+	{
+		// Hidden without collision it stops being relevant, so push the parked state out while clients
+		// still have its channel, then let it sleep; otherwise their copy flies on until relevancy times out
+		Projectile->LaunchState.bActive = false;
+		Projectile->ForceNetUpdate();
+		Projectile->SetNetDormancy(DORM_DormantAll);
+		Projectile->ResetForPool();
+
+		// A parked projectile must not keep the previous shooter alive
+		Projectile->SetOwner(nullptr);
+		Projectile->SetInstigator(nullptr);
+		Pool.Free.Add(Projectile);
+	}
+
+	UpdateStats();
+	return bPark;
+}
+
+void UDaProjectilePoolSubsystem::Prewarm(TSubclassOf<ADaProjectile> Class, int32 Count)
+{
+	const UWorld* World = GetWorld();
+	if (Class == nullptr || World == nullptr || World->GetNetMode() == NM_Client || !CVarProjectilePooling.GetValueOnGameThread())
+	{
+		return;
+	}
+
+	const ADaProjectile* ClassDefault = Class->GetDefaultObject<ADaProjectile>();
+	if (!ClassDefault->bAllowPooling)
+	{
+		return;
+	}
+
+	FProjectilePool& Pool = Pools.FindOrAdd(Class.Get());
+	const int32 Target = FMath::Min(Count, CVarProjectilePoolMaxFree.GetValueOnGameThread());
+	while (Pool.Free.Num() < Target)
+	{
+		ADaProjectile* Projectile = SpawnProjectile(Class, FTransform::Identity, nullptr, nullptr, true);
+		if (Projectile == nullptr)
+		{
+			LOG_WARNING("ProjectilePool: could not prewarm %s", *GetNameSafe(Class));
+			break;
+		}
+		Pool.Free.Add(Projectile);
+	}
+
+	UpdateStats();
+}
+
+void UDaProjectilePoolSubsystem::NotifyProjectileDestroyed(ADaProjectile* Projectile)
+{
+	if (!Projectile->bAcquiredFromPool)
+	{
+		return;
+	}
+	Projectile->bAcquiredFromPool = false;
+
+	if (FProjectilePool* Pool = Pools.Find(Projectile->GetClass()))
+	{
+		Pool->NumActive--;
+		TotalActive--;
+		UpdateStats();
+	}
+}
+
+int32 UDaProjectilePoolSubsystem::GetNumActive(TSubclassOf<ADaProjectile> Class) const
+{
+	const FProjectilePool* Pool = Pools.Find(Class.Get());
+	return Pool ? Pool->NumActive : 0;
+}
+
+int32 UDaProjectilePoolSubsystem::GetNumFree(TSubclassOf<ADaProjectile> Class) const
+{
+	const FProjectilePool* Pool = Pools.Find(Class.Get());
+	return Pool ? Pool->Free.Num() : 0;
+}
+
+int32 UDaProjectilePoolSubsystem::GetHighWaterMark(TSubclassOf<ADaProjectile> Class) const
+{
+	const FProjectilePool* Pool = Pools.Find(Class.Get());
+	return Pool ? Pool->HighWaterMark : 0;
+}
+
+void UDaProjectilePoolSubsystem::Deinitialize()
+{
+	// The world tears the actors down itself
+	Pools.Empty();
+	TotalActive = 0;
+	TotalHighWaterMark = 0;
+	UpdateStats();
+
+	Super::Deinitialize();
+}
+
+ADaProjectile* UDaProjectilePoolSubsystem::SpawnProjectile(TSubclassOf<ADaProjectile> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, bool bParked)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return nullptr;
+	}
+
+	ADaProjectile* Projectile = World->SpawnActorDeferred<ADaProjectile>(Class, SpawnTransform, Owner, Instigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Projectile == nullptr)
+	{
+		return nullptr;
+	}
+
+	// Parked from the start: BeginPlay hides it instead of launching
+	Projectile->LaunchState.bActive = !bParked;
+	Projectile->FinishSpawning(SpawnTransform);
+	if (bParked)
+	{
+		Projectile->SetNetDormancy(DORM_DormantAll);
+	}
+	return Projectile;
+}
+
+void UDaProjectilePoolSubsystem::UpdateStats() const
+{
+	int32 NumFree = 0;
+	for (const TPair<TObjectKey<UClass>, FProjectilePool>& Pair : Pools)
+	{
+		NumFree += Pair.Value.Free.Num();
+	}
+
+	SET_DWORD_STAT(STAT_DaProjectilesActive, TotalActive);
+	SET_DWORD_STAT(STAT_DaProjectilesPooled, NumFree);
+	SET_DWORD_STAT(STAT_DaProjectilesHighWater, TotalHighWaterMark);
+}
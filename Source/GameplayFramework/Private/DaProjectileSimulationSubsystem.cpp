@@ -0,0 +1,218 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "DaProjectileSimulationSubsystem.h"
+
+#include "Components/SphereComponent.h"
+#include "DaProjectile.h"
+#include "DaProjectilePoolSubsystem.h"
+#include "DaSimulatedImpactRelay.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "GameplayFramework.h"
+
+static TAutoConsoleVariable<int32> CVarMaxSimulatedProjectiles(TEXT("da.MaxSimulatedProjectiles"), 4096, TEXT("Projectiles UDaProjectileSimulationSubsystem flies at once; further launches spawn actors instead"), ECVF_Default);
+static TAutoConsoleVariable<float> CVarSimulatedProjectileLifeSpan(TEXT("da.SimulatedProjectileLifeSpan"), 10.0f, TEXT("Seconds a simulated projectile flies when its class has no InitialLifeSpan"), ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Simulation"), STAT_DaProjectileSimulation, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Projectiles"), STAT_DaSimulatedProjectiles, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Impacts Materialized"), STAT_DaSimulatedImpactsMaterialized, STATGROUP_DAGF);
+
+UDaProjectileSimulationSubsystem* UDaProjectileSimulationSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	return World ? World->GetSubsystem<UDaProjectileSimulationSubsystem>() : nullptr;
+}
+
+bool UDaProjectileSimulationSubsystem::CanSimulate(TSubclassOf<ADaProjectile> Class)
+{
+	return Class && Class->GetDefaultObject<ADaProjectile>()->SupportsBatchedSimulation();
+}
+
+bool UDaProjectileSimulationSubsystem::LaunchProjectile(TSubclassOf<ADaProjectile> Class, const FVector& Location, const FRotator& Rotation, APawn* Instigator)
+{
+	const UWorld* World = GetWorld();
+	if (World == nullptr || !CanSimulate(Class) || Projectiles.Num() >= CVarMaxSimulatedProjectiles.GetValueOnGameThread())
+	{
+		return false;
+	}
+
+	const ADaProjectile* Default = Class->GetDefaultObject<ADaProjectile>();
+	const UProjectileMovementComponent* Movement = Default->MovementComp;
+
+	// Same launch rule as UProjectileMovementComponent: InitialSpeed along the facing, else the default velocity's speed
+	const float Speed = Movement->InitialSpeed > 0.0f ? Movement->InitialSpeed : Movement->Velocity.Size();
+
+	FSimulatedProjectile& Projectile = Projectiles.AddDefaulted_GetRef();
+	Projectile.Location = Location;
+	Projectile.Velocity = Rotation.Vector() * Speed;
+	Projectile.GravityZ = Movement->ProjectileGravityScale * World->GetGravityZ();
+	Projectile.Radius = Default->SphereComp->GetScaledSphereRadius();
+	Projectile.TimeLeft = Default->InitialLifeSpan > 0.0f ? Default->InitialLifeSpan : CVarSimulatedProjectileLifeSpan.GetValueOnGameThread();
+	Projectile.Class = Class.Get();
+	Projectile.Instigator = Instigator;
+
+	SET_DWORD_STAT(STAT_DaSimulatedProjectiles, Projectiles.Num());
+	return true;
+}
+
+void UDaProjectileSimulationSubsystem::ForEachProjectile(TFunctionRef<void(const FVector& Location, const FVector& Velocity)> Visit) const
+{
+	for (const FSimulatedProjectile& Projectile : Projectiles)
+	{
+		Visit(Projectile.Location, Projectile.Velocity);
+	}
+}
+
+void UDaProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_DaProjectileSimulation);
+
+	const UWorld* World = GetWorld();
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(DaSimulatedProjectile), false);
+
+	// Step and sweep in one pass. Walking backwards lets finished projectiles swap-remove in
+	// place: whatever swaps into the hole has already been stepped this tick.
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; --Index)
+	{
+		FSimulatedProjectile& Projectile = Projectiles[Index];
+
+		Projectile.TimeLeft -= DeltaTime;
+		if (Projectile.TimeLeft <= 0.0f || !Projectile.Class.IsValid())
+		{
+			// Life span ran out: vanish without an impact, like the actor version
+			Projectiles.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		Projectile.Velocity.Z += Projectile.GravityZ * DeltaTime;
+		const FVector End = Projectile.Location + Projectile.Velocity * DeltaTime;
+
+		Params.ClearIgnoredActors();
+		if (const APawn* Instigator = Projectile.Instigator.Get())
+		{
+			// dont hit ourselves
+			Params.AddIgnoredActor(Instigator);
+		}
+
+		// Enemies overlap the projectile channel rather than block it. Like the actor, stop at the
+		// first blocking hit or at an overlap the class acts on; triggers, pickups and other
+		// overlap-only volumes are flown through.
+		SweepHits.Reset();
+		World->SweepMultiByChannel(SweepHits, Projectile.Location, End, FQuat::Identity, COLLISION_PROJECTILE, FCollisionShape::MakeSphere(Projectile.Radius), Params);
+		const ADaProjectile* Default = Projectile.Class->GetDefaultObject<ADaProjectile>();
+		const FHitResult* StopHit = SweepHits.FindByPredicate([Default](const FHitResult& Hit)
+		{
+			return Hit.bBlockingHit || Default->NeedsActorForSimulatedImpact(Hit);
+		});
+		if (StopHit)
+		{
+			FPendingImpact& Impact = PendingImpacts.AddDefaulted_GetRef();
+			Impact.Class = Projectile.Class;
+			Impact.Instigator = Projectile.Instigator;
+			Impact.Velocity = Projectile.Velocity;
+			Impact.Hit = *StopHit;
+
+			Projectiles.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		Projectile.Location = End;
+	}
+
+	// Resolved after the loop: impacts can launch or kill things that feed back into Projectiles
+	for (const FPendingImpact& Impact : PendingImpacts)
+	{
+		ResolveImpact(Impact);
+	}
+	PendingImpacts.Reset();
+
+	SendImpactCosmetics();
+
+	SET_DWORD_STAT(STAT_DaSimulatedProjectiles, Projectiles.Num());
+}
+
+void UDaProjectileSimulationSubsystem::ResolveImpact(const FPendingImpact& Impact)
+{
+	UClass* Class = Impact.Class.Get();
+	if (Class == nullptr)
+	{
+		return;
+	}
+
+	const ADaProjectile* Default = Class->GetDefaultObject<ADaProjectile>();
+	if (!Default->NeedsActorForSimulatedImpact(Impact.Hit))
+	{
+		// Played everywhere through the relay, this tick's impacts in one multicast
+		FDaSimulatedImpactCosmetic& Cosmetic = PendingCosmetics.AddDefaulted_GetRef();
+		Cosmetic.Class = Class;
+		Cosmetic.Location = Impact.Hit.Location;
+		return;
+	}
+
+	UDaProjectilePoolSubsystem* Pool = UDaProjectilePoolSubsystem::Get(this);
+	if (Pool == nullptr)
+	{
+		return;
+	}
+
+	APawn* Instigator = Impact.Instigator.Get();
+	const FTransform SpawnTransform(Impact.Velocity.Rotation(), Impact.Hit.Location);
+	ADaProjectile* Projectile = Pool->AcquireProjectile(Class, SpawnTransform, Instigator, Instigator);
+
+	// Appearing at the hit can already overlap the target and resolve the impact on its own
+	if (IsValid(Projectile) && !Projectile->IsPendingKillPending() && Projectile->IsActiveInPool())
+	{
+		Projectile->HandleSimulatedImpact(Impact.Hit);
+	}
+
+	INC_DWORD_STAT(STAT_DaSimulatedImpactsMaterialized);
+}
+
+void UDaProjectileSimulationSubsystem::SendImpactCosmetics()
+{
+	if (PendingCosmetics.Num() == 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!IsValid(ImpactRelay) && World)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ImpactRelay = World->SpawnActor<ADaSimulatedImpactRelay>(SpawnParams);
+	}
+
+	if (IsValid(ImpactRelay))
+	{
+		ImpactRelay->MulticastImpactCosmetics(PendingCosmetics);
+	}
+	PendingCosmetics.Reset();
+}
+
+TStatId UDaProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDaProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UDaProjectileSimulationSubsystem::Deinitialize()
+{
+	Projectiles.Empty();
+	PendingImpacts.Empty();
+	PendingCosmetics.Empty();
+	ImpactRelay = nullptr;
+	SET_DWORD_STAT(STAT_DaSimulatedProjectiles, 0);
+
+	Super::Deinitialize();
+}
@@ -22,6 +22,25 @@ ADaProjectile_Magic::ADaProjectile_Magic()
 
 void ADaProjectile_Magic::OnActorOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
                                          UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	ApplyImpact(OtherActor, SweepResult);
+}
+
+bool ADaProjectile_Magic::NeedsActorForSimulatedImpact(const FHitResult& Hit) const
+{
+	// Damage and parry run through the actor; a wall only needs the impact cosmetics
+	return Cast<IAbilitySystemInterface>(Hit.GetActor()) != nullptr;
+}
+
+void ADaProjectile_Magic::HandleSimulatedImpact(const FHitResult& Hit)
+{
+	if (!ApplyImpact(Hit.GetActor(), Hit))
+	{
+		Super::HandleSimulatedImpact(Hit);
+	}
+}
+
+bool ADaProjectile_Magic::ApplyImpact(AActor* OtherActor, const FHitResult& Hit)
 {
 	AActor* InstigatorActor = GetInstigator();
 	if (HasAuthority() && OtherActor && OtherActor != InstigatorActor)
@@ -48,7 +67,7 @@ void ADaProjectile_Magic::OnActorOverlap(UPrimitiveComponent* OverlappedComponen
 				// Set New instigator so our check above wont fail after Parry is complete
 				MovementComp->Velocity = -MovementComp->Velocity;
 				SetInstigator(Cast<APawn>(OtherActor));
-				return;
+				return true;
 			}
 
 			if (ensure(DamageEffect))
@@ -57,7 +76,7 @@ void ADaProjectile_Magic::OnActorOverlap(UPrimitiveComponent* OverlappedComponen
 				FGameplayEffectContextHandle EffectContext = InstigatorASC->MakeEffectContext();
 				EffectContext.AddSourceObject(this);
 				EffectContext.AddInstigator(InstigatorActor, this);
-				EffectContext.AddHitResult(SweepResult);
+				EffectContext.AddHitResult(Hit);
 				
 				FGameplayEffectSpecHandle NewHandle = InstigatorASC->MakeOutgoingSpec(DamageEffect, 0, EffectContext);
 				if (NewHandle.IsValid())
@@ -71,7 +90,7 @@ void ADaProjectile_Magic::OnActorOverlap(UPrimitiveComponent* OverlappedComponen
 				EventData.Instigator = InstigatorActor;
 				EventData.Target = OtherActor;
 				EventData.EventTag = CoreGameplayTags::TAG_Event_Damage;
-				EventData.OptionalObject = SweepResult.GetComponent();
+				EventData.OptionalObject = Hit.GetComponent();
 				EventData.EventMagnitude = DamageAmount;
 				
 				InstigatorASC->HandleGameplayEvent(CoreGameplayTags::TAG_Event_Damage, &EventData);
@@ -79,6 +98,8 @@ void ADaProjectile_Magic::OnActorOverlap(UPrimitiveComponent* OverlappedComponen
 			}
 			
 			Explode();
+			return true;
 		}
 	}
+	return false;
 }
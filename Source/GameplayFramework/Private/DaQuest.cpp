@@ -5,14 +5,42 @@
 #include "DaState.h"
 #include "GameplayFramework.h"
 
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarQuestValidateReplay(TEXT("da.QuestValidateReplay"), false, TEXT("Replay each quest's full input history after every incremental state machine step and log any disagreement"), ECVF_Cheat);
+#endif
+
 bool FQuestInProgress::UpdateQuest(const UObject* ObjectRef, UDaInputAtom* QuestActivity)
 {
 	// Only log activity to valid, in-progress quests. Check the blacklist/whitelist before logging
-	if (Quest && (QuestProgress == EQuestCompletion::EQC_Started) && (Quest->bInputBlackList != Quest->InputList.Contains(QuestActivity)))
+	if (Quest && Quest->QuestStateMachine && (QuestProgress == EQuestCompletion::EQC_Started) && (Quest->bInputBlackList != Quest->InputList.Contains(QuestActivity)))
 	{
 		QuestActivities.Add(QuestActivity);
-		FStateMachineResult QuestResult = Quest->QuestStateMachine->RunState(ObjectRef, QuestActivities);
-		switch (QuestResult.CompletionType)
+
+		EStateMachineCompletionType Completion;
+		if (const FDaStateTransitionTable* Table = Quest->GetTransitionTable())
+		{
+			Completion = AdvanceState(*Table, QuestActivity);
+
+#if !UE_BUILD_SHIPPING
+			if (CVarQuestValidateReplay.GetValueOnGameThread())
+			{
+				const FStateMachineResult Replayed = Quest->QuestStateMachine->RunState(ObjectRef, QuestActivities);
+				if (Replayed.CompletionType != Completion || Replayed.FinalState != CurrentState)
+				{
+					LOG_ERROR("Quest \"%s\": incremental state %s (%d) disagrees with replay %s (%d) after %d inputs",
+						*Quest->QuestName.ToString(), *GetNameSafe(CurrentState), static_cast<int32>(Completion),
+						*GetNameSafe(Replayed.FinalState), static_cast<int32>(Replayed.CompletionType), QuestActivities.Num());
+				}
+			}
+#endif
+		}
+		else
+		{
+			// Not tabulable (branch subclasses): replay the whole history
+			Completion = Quest->QuestStateMachine->RunState(ObjectRef, QuestActivities).CompletionType;
+		}
+
+		switch (Completion)
 		{
 		case EStateMachineCompletionType::Accepted:
 			QuestProgress = EQuestCompletion::EQC_Succeeded;
@@ -28,6 +56,51 @@ bool FQuestInProgress::UpdateQuest(const UObject* ObjectRef, UDaInputAtom* Quest
 	return false;
 }
 
+EStateMachineCompletionType FQuestInProgress::AdvanceState(const FDaStateTransitionTable& Table, const UDaInputAtom* QuestActivity)
+{
+	auto Step = [this, &Table](const UDaInputAtom* Input)
+	{
+		// RunState reads the root before any input, so a terminating root ends the run at once
+		if (!Table.States.IsValidIndex(CurrentStateIndex))
+		{
+			CurrentStateIndex = 0;
+			bMachineHalted = Table.States[0].bTerminal;
+		}
+
+		if (!bMachineHalted)
+		{
+			const int32 Next = Table.Advance(CurrentStateIndex, Input);
+			if (Next == FDaStateTransitionTable::Halt)
+			{
+				bMachineHalted = true;
+			}
+			else if (Next != FDaStateTransitionTable::Loop)
+			{
+				CurrentStateIndex = Next;
+				bMachineHalted = Table.States[Next].bTerminal;
+			}
+		}
+		CurrentState = Table.States[CurrentStateIndex].State;
+	};
+
+	// QuestActivity is already the last element of QuestActivities. If our position does not match
+	// the table (it was rebuilt by an edit during PIE, or this quest was evaluated by replay until
+	// now), re-derive it once from the earlier history.
+	const bool bPositionKnown = Table.States.IsValidIndex(CurrentStateIndex) && Table.States[CurrentStateIndex].State == CurrentState;
+	if (!bPositionKnown && QuestActivities.Num() > 1)
+	{
+		CurrentStateIndex = INDEX_NONE;
+		bMachineHalted = false;
+		for (int32 i = 0; i < QuestActivities.Num() - 1; ++i)
+		{
+			Step(QuestActivities[i]);
+		}
+	}
+
+	Step(QuestActivity);
+	return Table.States[CurrentStateIndex].CompletionType;
+}
+
 void UDaQuestComponent::UpdateQuests(UDaInputAtom* QuestActivity)
 {
 	TArray<int32> RecentlyCompletedQuests;
@@ -83,6 +156,39 @@ bool UDaQuestComponent::BeginQuest(const UDaQuest* Quest)
 	return true;
 }
 
+const FDaStateTransitionTable* UDaQuest::GetTransitionTable() const
+{
+#if WITH_EDITOR
+	// States and branches are separate assets; an edit to any of them may change this machine
+	if (bTableCompiled && CompiledGeneration != UDaState::EditGeneration)
+	{
+		bTableCompiled = false;
+	}
+#endif
+
+	if (!bTableCompiled)
+	{
+		bTableCompiled = true;
+		CompiledTable.States.Reset();
+#if WITH_EDITOR
+		CompiledGeneration = UDaState::EditGeneration;
+#endif
+		if (QuestStateMachine && !QuestStateMachine->CompileTransitionTable(CompiledTable))
+		{
+			LOG("Quest \"%s\" uses custom branches, evaluating by replay", *QuestName.ToString());
+		}
+	}
+	return CompiledTable.IsValid() ? &CompiledTable : nullptr;
+}
+
+#if WITH_EDITOR
+void UDaQuest::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	bTableCompiled = false;
+}
+#endif
+
 void UDaQuest::OnSucceed(UDaQuestComponent* QuestStatus) const
 {
 	LOG_WARNING("Quest \"%s\" Succeeded!", *QuestName.ToString());
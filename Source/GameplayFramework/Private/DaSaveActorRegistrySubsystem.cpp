@@ -0,0 +1,252 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "DaSaveActorRegistrySubsystem.h"
+
+#include "DaSaveInterface.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameplayFramework.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Save Actors Registered"), STAT_DaSaveActorsRegistered, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Save Actors Serialized"), STAT_DaSaveActorsSerialized, STATGROUP_DAGF);
+
+UDaSaveActorRegistrySubsystem* UDaSaveActorRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	return World ? World->GetSubsystem<UDaSaveActorRegistrySubsystem>() : nullptr;
+}
+
+void UDaSaveActorRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UWorld* World = GetWorld())
+	{
+		ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &ThisClass::HandleActorSpawned));
+	}
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &ThisClass::HandleLevelAddedToWorld);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &ThisClass::HandleLevelRemovedFromWorld);
+}
+
+void UDaSaveActorRegistrySubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	Records.Empty();
+	IndexByActor.Empty();
+	SET_DWORD_STAT(STAT_DaSaveActorsRegistered, 0);
+
+	Super::Deinitialize();
+}
+
+void UDaSaveActorRegistrySubsystem::MarkSaveDirty(AActor* Actor)
+{
+	if (const int32* Index = IndexByActor.Find(Actor))
+	{
+		Records[*Index].bDirty = true;
+	}
+	else
+	{
+		// Marking is a hint that the actor is saveable, register it if it slipped past the spawn hooks
+		RegisterActor(Actor);
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::MarkSaveDirtyFor(AActor* Actor)
+{
+	if (UDaSaveActorRegistrySubsystem* Registry = Get(Actor))
+	{
+		Registry->MarkSaveDirty(Actor);
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::MarkAllSaveDirty()
+{
+	for (FSaveActorRecord& Record : Records)
+	{
+		Record.bDirty = true;
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::RegisterActor(AActor* Actor)
+{
+	if (Actor == nullptr || Actor->GetWorld() != GetWorld() || !Actor->Implements<UDaSaveInterface>() || IndexByActor.Contains(Actor))
+	{
+		return;
+	}
+
+	FSaveActorRecord& Record = Records.AddDefaulted_GetRef();
+	Record.Actor = Actor;
+	Record.Key = Actor;
+	Record.bTracksDirty = IDaSaveInterface::Execute_SupportsSaveDirtyTracking(Actor);
+	IndexByActor.Add(Actor, Records.Num() - 1);
+
+	SET_DWORD_STAT(STAT_DaSaveActorsRegistered, Records.Num());
+}
+
+void UDaSaveActorRegistrySubsystem::UnregisterActor(AActor* Actor)
+{
+	if (const int32* Index = IndexByActor.Find(Actor))
+	{
+		RemoveRecordAt(*Index);
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::GatherSaveRecords(TArray<FActorSaveData>& OutRecords)
+{
+	EnsureLevelsScanned();
+	PruneRecords();
+
+	OutRecords.Reserve(OutRecords.Num() + Records.Num());
+
+	NumSerializedLastSave = 0;
+	for (FSaveActorRecord& Record : Records)
+	{
+		AActor* Actor = Record.Actor.Get();
+
+		Record.Cached.ActorName = Actor->GetFName();
+		Record.Cached.Transform = Actor->GetActorTransform();
+
+		if (Record.bDirty || !Record.bTracksDirty)
+		{
+			Record.Cached.ByteData.Reset();
+
+			// Pass the array to fill with data from Actor
+			FMemoryWriter MemWriter(Record.Cached.ByteData);
+
+			FObjectAndNameAsStringProxyArchive Ar(MemWriter, true);
+			// Find only variables with UPROPERTY(SaveGame)
+			Ar.ArIsSaveGame = true;
+			// Converts Actor's SaveGame UPROPERTIES into binary array
+			Actor->Serialize(Ar);
+
+			Record.bDirty = false;
+			NumSerializedLastSave++;
+		}
+
+		OutRecords.Add(Record.Cached);
+	}
+
+	INC_DWORD_STAT_BY(STAT_DaSaveActorsSerialized, NumSerializedLastSave);
+}
+
+void UDaSaveActorRegistrySubsystem::ForEachSaveActor(TFunctionRef<void(AActor&)> Visit)
+{
+	EnsureLevelsScanned();
+	PruneRecords();
+
+	for (const FSaveActorRecord& Record : Records)
+	{
+		if (AActor* Actor = Record.Actor.Get())
+		{
+			Visit(*Actor);
+		}
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::HandleActorSpawned(AActor* Actor)
+{
+	RegisterActor(Actor);
+}
+
+void UDaSaveActorRegistrySubsystem::HandleLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	// Before the first query the initial scan covers every visible level anyway
+	if (World == GetWorld() && bLevelsScanned)
+	{
+		RegisterLevel(Level);
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World)
+{
+	if (World != GetWorld() || Level == nullptr)
+	{
+		return;
+	}
+
+	// Streamed-out actors are not destroyed one by one and linger until GC; drop them with their level,
+	// or streaming it back in would register a second record under the same ActorName
+	for (int32 Index = Records.Num() - 1; Index >= 0; Index--)
+	{
+		const AActor* Actor = Records[Index].Actor.Get();
+		if (Actor == nullptr || Actor->GetLevel() == Level)
+		{
+			RemoveRecordAt(Index);
+		}
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::RegisterLevel(const ULevel* Level)
+{
+	if (Level == nullptr)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		if (Actor && !Actor->IsPendingKillPending())
+		{
+			RegisterActor(Actor);
+		}
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::EnsureLevelsScanned()
+{
+	if (bLevelsScanned)
+	{
+		return;
+	}
+	bLevelsScanned = true;
+
+	// One pass per world lifetime; spawns and streamed-in levels are picked up by the delegates from here on
+	if (const UWorld* World = GetWorld())
+	{
+		for (const ULevel* Level : World->GetLevels())
+		{
+			// The persistent level counts even before it is flagged visible: LoadSaveGame runs from InitGame
+			if (Level && (Level == World->PersistentLevel || Level->bIsVisible))
+			{
+				RegisterLevel(Level);
+			}
+		}
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::PruneRecords()
+{
+	for (int32 Index = Records.Num() - 1; Index >= 0; Index--)
+	{
+		const AActor* Actor = Records[Index].Actor.Get();
+		if (Actor == nullptr || Actor->IsPendingKillPending())
+		{
+			RemoveRecordAt(Index);
+		}
+	}
+}
+
+void UDaSaveActorRegistrySubsystem::RemoveRecordAt(int32 Index)
+{
+	IndexByActor.Remove(Records[Index].Key);
+
+	// Swap-remove, then point the moved actor's entry at its new slot
+	Records.RemoveAtSwap(Index);
+	if (Records.IsValidIndex(Index))
+	{
+		IndexByActor.Add(Records[Index].Key, Index);
+	}
+
+	SET_DWORD_STAT(STAT_DaSaveActorsRegistered, Records.Num());
+}
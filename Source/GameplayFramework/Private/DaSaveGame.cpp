@@ -4,7 +4,10 @@
 #include "DaSaveGame.h"
 
 #include "GameplayFramework.h"
+#include "GameFramework/GameStateBase.h"
 #include "GameFramework/PlayerState.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/AutomationTest.h"
 
 FPlayerSaveData* UDaSaveGame::GetPlayerData(APlayerState* PlayerState)
 {
@@ -13,49 +16,228 @@ FPlayerSaveData* UDaSaveGame::GetPlayerData(APlayerState* PlayerState)
 		return nullptr;
 	}
 
-	// Will not give unique ID while PIE so we skip that step while testing in editor.
-	// UObjects don't have access to UWorld, so we grab it via PlayerState instead
-	if (PlayerState->GetWorld()->IsPlayInEditor())
+	const FString PlayerID = GetPlayerSaveID(PlayerState);
+	if (FPlayerSaveData* Found = FindPlayerData(PlayerID))
+	{
+		return Found;
+	}
+
+	// A save written outside the editor is keyed by online IDs; in PIE fall back to the same position
+	int32 PIEIndex = INDEX_NONE;
+	if (PlayerID.StartsWith(TEXT("PIE_")) && LexTryParseString(PIEIndex, *PlayerID.RightChop(4)) && SavedPlayers.IsValidIndex(PIEIndex))
 	{
-		LOG("During PIE we cannot use PlayerID to retrieve Saved Player data. Using first entry in array if available.");
+		LOG("During PIE we cannot use PlayerID to retrieve Saved Player data. Using entry %d in array.", PIEIndex);
+		return &SavedPlayers[PIEIndex];
+	}
+	return nullptr;
+}
 
-		if (SavedPlayers.IsValidIndex(0))
+FPlayerSaveData* UDaSaveGame::FindPlayerData(const FString& PlayerID)
+{
+	const int32* Index = PlayerIndexByID.Find(PlayerID);
+	if (Index == nullptr || !SavedPlayers.IsValidIndex(*Index) || SavedPlayers[*Index].PlayerID != PlayerID)
+	{
+		// SavedPlayers is public, so the index can fall behind an edit made directly on the array
+		if (IndexedPlayerCount != SavedPlayers.Num() || Index != nullptr)
 		{
-			return &SavedPlayers[0];
+			RebuildPlayerIndex();
+			Index = PlayerIndexByID.Find(PlayerID);
 		}
+	}
 
-		// No saved player data available
-		return nullptr;
+	return Index ? &SavedPlayers[*Index] : nullptr;
+}
+
+FPlayerSaveData& UDaSaveGame::FindOrAddPlayerData(const FString& PlayerID)
+{
+	if (FPlayerSaveData* Existing = FindPlayerData(PlayerID))
+	{
+		return *Existing;
+	}
+
+	const int32 Index = SavedPlayers.AddDefaulted();
+	SavedPlayers[Index].PlayerID = PlayerID;
+	PlayerIndexByID.Add(PlayerID, Index);
+	IndexedPlayerCount = SavedPlayers.Num();
+	return SavedPlayers[Index];
+}
+
+FString UDaSaveGame::GetPlayerSaveID(const APlayerState* PlayerState)
+{
+	if (PlayerState == nullptr)
+	{
+		return FString();
+	}
+
+	// Will not give unique ID while PIE so we key by join order while testing in editor.
+	// UObjects don't have access to UWorld, so we grab it via PlayerState instead
+	const UWorld* World = PlayerState->GetWorld();
+	if ((World && World->IsPlayInEditor()) || !PlayerState->GetUniqueId().IsValid())
+	{
+		const AGameStateBase* GS = World ? World->GetGameState() : nullptr;
+		const int32 PlayerIndex = GS ? GS->PlayerArray.IndexOfByKey(PlayerState) : INDEX_NONE;
+		return FString::Printf(TEXT("PIE_%d"), FMath::Max(PlayerIndex, 0));
 	}
 
 	// Easiest way to deal with the different IDs is as FString (original Steam id is uint64)
 	// Keep in mind that GetUniqueId() returns the online id, where GetUniqueID() is a function from UObject (very confusing...)
-	FString PlayerID = PlayerState->GetUniqueId()->ToString();
-	//int32 PlayerID = PlayerState->GetPlayerId();
-	// Iterate the array and match by PlayerID (eg. unique ID provided by Steam)
-	return SavedPlayers.FindByPredicate([&](const FPlayerSaveData& Data) { return Data.PlayerID == PlayerID; });
+	return PlayerState->GetUniqueId()->ToString();
 }
 
-FSavedMap UDaSaveGame::GetSavedMapWithMapName(const FString& InMapName)
+void UDaSaveGame::Serialize(FArchive& Ar)
 {
-	for (const FSavedMap& Map : SavedMaps)
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading())
 	{
-		if (Map.MapAssetName == InMapName)
+		RebuildPlayerIndex();
+	}
+}
+
+void UDaSaveGame::RebuildPlayerIndex()
+{
+	PlayerIndexByID.Reset();
+	PlayerIndexByID.Reserve(SavedPlayers.Num());
+	for (int32 i = 0; i < SavedPlayers.Num(); i++)
+	{
+		// Older saves could hold a player twice; the first entry is the one the linear scan used to return
+		if (!PlayerIndexByID.Contains(SavedPlayers[i].PlayerID))
 		{
-			return Map;
+			PlayerIndexByID.Add(SavedPlayers[i].PlayerID, i);
 		}
 	}
-	return FSavedMap();
+	IndexedPlayerCount = SavedPlayers.Num();
+}
+
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+FSavedMap UDaSaveGame::GetSavedMapWithMapName(const FString& InMapName)
+{
+	const FSavedMap* Map = FindSavedMap(InMapName);
+	return Map ? *Map : FSavedMap();
+}
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+const FSavedMap* UDaSaveGame::FindSavedMap(const FString& InMapName) const
+{
+	return SavedMaps.FindByPredicate([&](const FSavedMap& Map) { return Map.MapAssetName == InMapName; });
 }
 
 bool UDaSaveGame::HasMap(const FString& InMapName)
 {
-	for (const FSavedMap& Map : SavedMaps)
+	return FindMapManifestEntry(InMapName) != nullptr
+		|| SavedMaps.ContainsByPredicate([&](const FSavedMap& Map) { return Map.MapAssetName == InMapName; });
+}
+
+const FDaSavedMapManifestEntry* UDaSaveGame::FindMapManifestEntry(const FString& InMapName) const
+{
+	return MapManifest.FindByPredicate([&](const FDaSavedMapManifestEntry& Entry) { return Entry.MapAssetName == InMapName; });
+}
+
+FDaSavedMapManifestEntry& UDaSaveGame::FindOrAddMapManifestEntry(const FString& InMapName)
+{
+	if (FDaSavedMapManifestEntry* Existing = MapManifest.FindByPredicate([&](const FDaSavedMapManifestEntry& Entry) { return Entry.MapAssetName == InMapName; }))
+	{
+		return *Existing;
+	}
+
+	FDaSavedMapManifestEntry& Entry = MapManifest.AddDefaulted_GetRef();
+	Entry.MapAssetName = InMapName;
+	return Entry;
+}
+
+FString UDaSaveGame::GetMapShardSlotName(const FString& SlotName, const FString& InMapName, int32 Generation)
+{
+	// Map asset paths are not valid slot names, hash them; the manifest keeps the readable name
+	if (Generation == 0)
+	{
+		return FString::Printf(TEXT("%s_Map_%08X"), *SlotName, FCrc::StrCrc32(*InMapName));
+	}
+	return FString::Printf(TEXT("%s_Map_%08X_G%d"), *SlotName, FCrc::StrCrc32(*InMapName), Generation);
+}
+
+int32 FDaActorSaveIndex::Build(TConstArrayView<FActorSaveData> InRecords)
+{
+	Records = InRecords;
+	IndexByName.Reset();
+	IndexByName.Reserve(Records.Num());
+
+	int32 NumDuplicates = 0;
+	for (int32 i = 0; i < Records.Num(); i++)
+	{
+		int32& Index = IndexByName.FindOrAdd(Records[i].ActorName, INDEX_NONE);
+		if (Index != INDEX_NONE)
+		{
+			NumDuplicates++;
+		}
+		Index = i;
+	}
+	return NumDuplicates;
+}
+
+const FActorSaveData* FDaActorSaveIndex::Find(FName ActorName) const
+{
+	const int32* Index = IndexByName.Find(ActorName);
+	return Index ? &Records[*Index] : nullptr;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Serializes synthetic players through SaveGameToMemory / LoadGameFromMemory and checks every one
+// comes back through the rebuilt PlayerID index, and that re-saving updates entries in place.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDaSaveRoundTripPlayersTest, "GameplayFramework.SaveGame.RoundTripPlayers",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDaSaveRoundTripPlayersTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumPlayers = 256;
+
+	auto MakeID = [](int32 Index) { return FString::Printf(TEXT("RoundTrip_%d"), Index); };
+
+	UDaSaveGame* Source = NewObject<UDaSaveGame>();
+	for (int32 i = 0; i < NumPlayers; i++)
 	{
-		if (Map.MapAssetName == InMapName)
+		FPlayerSaveData& Data = Source->FindOrAddPlayerData(MakeID(i));
+		Data.Credits = i;
+		Data.Level = i % 100;
+		Data.Location = FVector(i, -i, 0.0f);
+	}
+
+	TArray<uint8> Bytes;
+	UDaSaveGame* Loaded = UGameplayStatics::SaveGameToMemory(Source, Bytes)
+		? Cast<UDaSaveGame>(UGameplayStatics::LoadGameFromMemory(Bytes))
+		: nullptr;
+	if (!TestNotNull(TEXT("Round tripped save object"), Loaded))
+	{
+		return false;
+	}
+
+	// Back to front, so a lookup that only works in insertion order fails
+	for (int32 i = NumPlayers - 1; i >= 0; i--)
+	{
+		const FPlayerSaveData* Data = Loaded->FindPlayerData(MakeID(i));
+		if (!TestNotNull(*FString::Printf(TEXT("Player %d found"), i), Data))
 		{
-			return true;
+			continue;
 		}
+		TestEqual(TEXT("Credits"), Data->Credits, i);
+		TestEqual(TEXT("Level"), Data->Level, i % 100);
+		TestTrue(TEXT("Location"), Data->Location.Equals(FVector(i, -i, 0.0f)));
+	}
+	TestNull(TEXT("Unknown player"), Loaded->FindPlayerData(TEXT("RoundTrip_Missing")));
+
+	// Saving the same players again must overwrite, not append
+	for (int32 i = 0; i < NumPlayers; i++)
+	{
+		Loaded->FindOrAddPlayerData(MakeID(i)).Credits = i + 1;
 	}
-	return false;
-}
\ No newline at end of file
+	TestEqual(TEXT("Players after re-save"), Loaded->SavedPlayers.Num(), NumPlayers);
+	for (int32 i = 0; i < NumPlayers; i++)
+	{
+		const FPlayerSaveData* Data = Loaded->FindPlayerData(MakeID(i));
+		TestTrue(*FString::Printf(TEXT("Player %d updated in place"), i), Data && Data->Credits == i + 1);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
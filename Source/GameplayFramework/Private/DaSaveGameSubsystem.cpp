@@ -4,16 +4,101 @@
 #include "DaSaveGameSubsystem.h"
 
 #include "DaGameInstanceBase.h"
-#include "EngineUtils.h"
 #include "DaPlayerState.h"
+#include "DaSaveActorRegistrySubsystem.h"
 #include "DaSaveGame.h"
 #include "DaSaveGameSettings.h"
 #include "GameplayFramework.h"
 #include "GameFramework/GameStateBase.h"
 #include "DaSaveInterface.h"
+#include "Async/Async.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryReader.h"
 #include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 
+static TAutoConsoleVariable<bool> CVarAsyncSaveGame(TEXT("da.AsyncSaveGame"), true, TEXT("Write save games to disk on a worker thread; the game thread only serializes the save into memory"), ECVF_Default);
+static TAutoConsoleVariable<bool> CVarCompressSaveGame(TEXT("da.CompressSaveGame"), true, TEXT("Oodle-compress save games before writing them; uncompressed saves still load"), ECVF_Default);
+
+DECLARE_CYCLE_STAT(TEXT("SaveGame Snapshot"), STAT_DaSaveGameSnapshot, STATGROUP_DAGF);
+DECLARE_CYCLE_STAT(TEXT("SaveGame Write"), STAT_DaSaveGameWrite, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("SaveGame Writes Coalesced"), STAT_DaSaveGameWritesCoalesced, STATGROUP_DAGF);
+
+namespace DaSaveGameFile
+{
+	// Leads a compressed slot, followed by the uncompressed size. A plain SaveGameToMemory blob starts
+	// with the engine's 'GVAS' tag instead, so saves written before compression still load.
+	static constexpr uint32 CompressedTag = 0x5A5A4144; // 'DAZZ'
+	static constexpr int32 HeaderSize = sizeof(uint32) + sizeof(int32);
+
+	// Safe off the game thread: touches only the bytes and the platform save system
+	static bool WriteToSlot(const TArray<uint8>& Bytes, bool bCompress, const FString& SlotName, int32 SlotIndex)
+	{
+		if (!bCompress)
+		{
+			return UGameplayStatics::SaveDataToSlot(Bytes, SlotName, SlotIndex);
+		}
+
+		const int32 RawSize = Bytes.Num();
+		const int32 Bound = FCompression::CompressMemoryBound(NAME_Oodle, RawSize);
+
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(HeaderSize + Bound);
+		FMemory::Memcpy(Compressed.GetData(), &CompressedTag, sizeof(uint32));
+		FMemory::Memcpy(Compressed.GetData() + sizeof(uint32), &RawSize, sizeof(int32));
+
+		int32 CompressedSize = Bound;
+		if (!FCompression::CompressMemory(NAME_Oodle, Compressed.GetData() + HeaderSize, CompressedSize, Bytes.GetData(), RawSize))
+		{
+			// Still worth having the save on disk, just larger
+			return UGameplayStatics::SaveDataToSlot(Bytes, SlotName, SlotIndex);
+		}
+		Compressed.SetNum(HeaderSize + CompressedSize);
+
+		return UGameplayStatics::SaveDataToSlot(Compressed, SlotName, SlotIndex);
+	}
+
+	// Slot contents as SaveGameToMemory produced them, decompressed if needed
+	static bool LoadRawFromSlot(const FString& SlotName, int32 SlotIndex, TArray<uint8>& OutRaw)
+	{
+		TArray<uint8> Bytes;
+		if (!UGameplayStatics::LoadDataFromSlot(Bytes, SlotName, SlotIndex))
+		{
+			return false;
+		}
+
+		uint32 Tag = 0;
+		if (Bytes.Num() >= HeaderSize)
+		{
+			FMemory::Memcpy(&Tag, Bytes.GetData(), sizeof(uint32));
+		}
+		if (Tag != CompressedTag)
+		{
+			OutRaw = MoveTemp(Bytes);
+			return true;
+		}
+
+		int32 RawSize = 0;
+		FMemory::Memcpy(&RawSize, Bytes.GetData() + sizeof(uint32), sizeof(int32));
+
+		OutRaw.SetNumUninitialized(FMath::Max(RawSize, 0));
+		if (RawSize <= 0 || !FCompression::UncompressMemory(NAME_Oodle, OutRaw.GetData(), RawSize, Bytes.GetData() + HeaderSize, Bytes.Num() - HeaderSize))
+		{
+			LOG_ERROR("SaveGame slot '%s' (%d) is corrupt, failed to decompress.", *SlotName, SlotIndex);
+			OutRaw.Reset();
+			return false;
+		}
+		return true;
+	}
+
+	static USaveGame* LoadFromSlot(const FString& SlotName, int32 SlotIndex)
+	{
+		TArray<uint8> Raw;
+		return LoadRawFromSlot(SlotName, SlotIndex, Raw) ? UGameplayStatics::LoadGameFromMemory(Raw) : nullptr;
+	}
+}
+
 void UDaSaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -24,13 +109,27 @@ void UDaSaveGameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	//LoadSlotName = SGSettings->SaveSlotName;
 }
 
+void UDaSaveGameSubsystem::Deinitialize()
+{
+	// Don't lose a death or checkpoint save queued right before quitting
+	FlushWrites();
+
+	Super::Deinitialize();
+}
+
 /* Static */
 UDaSaveGame* UDaSaveGameSubsystem::GetSaveSlotData(const FString& SlotName, int32 SlotIndex) const
 {
+	// The disk copy is behind while a write for this slot is still queued or on the worker
+	if (UDaSaveGame* Unwritten = Cast<UDaSaveGame>(FindUnwrittenSave(SlotName, SlotIndex)))
+	{
+		return Unwritten;
+	}
+
 	USaveGame* SaveGameObject = nullptr;
 	if (UGameplayStatics::DoesSaveGameExist(SlotName, SlotIndex))
 	{
-		SaveGameObject = UGameplayStatics::LoadGameFromSlot(SlotName, SlotIndex);
+		SaveGameObject = DaSaveGameFile::LoadFromSlot(SlotName, SlotIndex);
 	}
 	else
 	{
@@ -53,6 +152,17 @@ void UDaSaveGameSubsystem::DeleteSlot(const FString& SlotName, int32 SlotIndex)
 {
 	if (UGameplayStatics::DoesSaveGameExist(SlotName, SlotIndex))
 	{
+		// Map shards live in their own slots, the manifest is the only record of them
+		if (const UDaSaveGame* SaveGame = Cast<UDaSaveGame>(DaSaveGameFile::LoadFromSlot(SlotName, SlotIndex)))
+		{
+			for (const FDaSavedMapManifestEntry& Entry : SaveGame->MapManifest)
+			{
+				if (UGameplayStatics::DoesSaveGameExist(Entry.ShardSlotName, SlotIndex))
+				{
+					UGameplayStatics::DeleteGameInSlot(Entry.ShardSlotName, SlotIndex);
+				}
+			}
+		}
 		UGameplayStatics::DeleteGameInSlot(SlotName, SlotIndex);
 	}
 }
@@ -80,9 +190,8 @@ void UDaSaveGameSubsystem::SaveInGameProgressData(TFunction<void(UDaSaveGame*)>
 
 	// Save world and everything else
 	WriteSaveGame();
-	
-	UGameplayStatics::SaveGameToSlot(CurrentSaveGame, InGameLoadSlotName, InGameLoadSlotIndex);
-	OnSaveGameWritten.Broadcast(CurrentSaveGame);
+
+	CommitToSlot(InGameLoadSlotName, InGameLoadSlotIndex);
 }
 
 void UDaSaveGameSubsystem::DebugLogCurrentSaveGameInfo(const FString& AdditionalLoggingText)
@@ -93,20 +202,359 @@ void UDaSaveGameSubsystem::DebugLogCurrentSaveGameInfo(const FString& Additional
 void UDaSaveGameSubsystem::SaveSlotData(const FString& LoadSlotName, int32 SlotIndex, bool bClearExisting,
                                         TFunction<void(UDaSaveGame*)> SaveDataCallback)
 {
-	if (UGameplayStatics::DoesSaveGameExist(LoadSlotName, SlotIndex))
+	if (bClearExisting)
 	{
-		if (bClearExisting)
-		{
-			UGameplayStatics::DeleteGameInSlot(LoadSlotName, SlotIndex);
-		}
+		// A queued write would otherwise recreate the slot right after we delete it
+		FlushWrites();
+		DeleteSlot(LoadSlotName, SlotIndex);
 	}
 
 	// Load SaveGame Data from slot, if it doesn't exist create new one, either way save it as current
 	CurrentSaveGame = GetSaveSlotData(LoadSlotName, SlotIndex);
 
 	SaveDataCallback(CurrentSaveGame);
-	UGameplayStatics::SaveGameToSlot(CurrentSaveGame, LoadSlotName, SlotIndex);
-	OnSaveGameWritten.Broadcast(CurrentSaveGame);
+	CommitToSlot(LoadSlotName, SlotIndex);
+}
+
+void UDaSaveGameSubsystem::CommitToSlot(const FString& SlotName, int32 SlotIndex)
+{
+	if (CurrentSaveGame == nullptr)
+	{
+		return;
+	}
+
+	// Snapshot: the only part that has to run on the game thread
+	FPendingWrite Write;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DaSaveGameSnapshot);
+		const double StartTime = FPlatformTime::Seconds();
+
+		// Shard first, it fills in the manifest entry the main save carries. Cleared before, a shard
+		// write that fails on the spot sets it again.
+		if (CurrentMapShard && bCurrentMapShardDirty)
+		{
+			bCurrentMapShardDirty = false;
+			QueueShardWrite(CurrentMapShard, SlotName, SlotIndex);
+		}
+
+		const bool bSerialized = SnapshotToWrite(CurrentSaveGame, SlotName, SlotIndex, Write);
+		LastSnapshotMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		if (!bSerialized)
+		{
+			FinishWrite(Write, false);
+			return;
+		}
+
+		for (const FDaSavedMapManifestEntry& Entry : CurrentSaveGame->MapManifest)
+		{
+			if (IsSlotUnwritten(Entry.ShardSlotName, SlotIndex))
+			{
+				Write.RequiredShardSlots.Add(Entry.ShardSlotName);
+			}
+		}
+		Write.SupersededShardSlots = MoveTemp(SupersededShardSlots);
+		SupersededShardSlots.Reset();
+	}
+
+	QueueWrite(MoveTemp(Write));
+}
+
+bool UDaSaveGameSubsystem::SnapshotToWrite(USaveGame* SaveObject, const FString& SlotName, int32 SlotIndex, FPendingWrite& OutWrite) const
+{
+	OutWrite.SlotName = SlotName;
+	OutWrite.SlotIndex = SlotIndex;
+	OutWrite.SaveObject = SaveObject;
+	OutWrite.bCompress = CVarCompressSaveGame.GetValueOnGameThread();
+
+	if (!UGameplayStatics::SaveGameToMemory(SaveObject, OutWrite.Bytes))
+	{
+		LOG_ERROR("Failed to serialize %s for slot '%s' (%d).", *GetNameSafe(SaveObject), *SlotName, SlotIndex);
+		return false;
+	}
+	return true;
+}
+
+void UDaSaveGameSubsystem::QueueShardWrite(UDaSavedMapShard* Shard, const FString& SlotName, int32 SlotIndex)
+{
+	FDaSavedMapManifestEntry& Entry = CurrentSaveGame->FindOrAddMapManifestEntry(Shard->Map.MapAssetName);
+
+	// Never overwrite the shard the main save on disk points at: a save interrupted between the two
+	// writes then still finds the old manifest entry and the old shard it checksummed
+	const int32 Generation = Entry.Generation + 1;
+	const FString ShardSlotName = UDaSaveGame::GetMapShardSlotName(SlotName, Shard->Map.MapAssetName, Generation);
+
+	FPendingWrite Write;
+	if (!SnapshotToWrite(Shard, ShardSlotName, SlotIndex, Write))
+	{
+		return;
+	}
+	Write.ShardMapName = Shard->Map.MapAssetName;
+	Write.PreviousShardEntry = Entry;
+	Write.ManifestOwner = CurrentSaveGame;
+
+	Entry.ShardSlotName = ShardSlotName;
+	Entry.Generation = Generation;
+	Entry.Checksum = FCrc::MemCrc32(Write.Bytes.GetData(), Write.Bytes.Num());
+	Entry.NumActors = Shard->Map.SavedActors.Num();
+
+	QueueWrite(MoveTemp(Write));
+}
+
+void UDaSaveGameSubsystem::QueueWrite(FPendingWrite&& Write)
+{
+	// Synchronous mode still has to queue behind a write that is already on the worker
+	if (!CVarAsyncSaveGame.GetValueOnGameThread() && !IsSaveInFlight())
+	{
+		WriteNow(Write);
+		return;
+	}
+
+	// Only the newest state of a slot matters: drop what is still waiting rather than writing it twice.
+	// Not replaced in place, the new write has to land after the shard writes queued for it.
+	const int32 QueuedIndex = PendingWrites.IndexOfByPredicate([&](const FPendingWrite& Pending)
+	{
+		return Pending.SlotIndex == Write.SlotIndex && Pending.SlotName == Write.SlotName;
+	});
+	if (QueuedIndex != INDEX_NONE)
+	{
+		// The dropped write never lands, so the shards it was to retire pass to this one
+		for (const FString& ShardSlot : PendingWrites[QueuedIndex].SupersededShardSlots)
+		{
+			Write.SupersededShardSlots.AddUnique(ShardSlot);
+		}
+		PendingWrites.RemoveAt(QueuedIndex);
+		INC_DWORD_STAT(STAT_DaSaveGameWritesCoalesced);
+	}
+
+	PendingWrites.Add(MoveTemp(Write));
+	if (!bWriteInFlight)
+	{
+		StartNextWrite();
+	}
+}
+
+void UDaSaveGameSubsystem::WriteNow(const FPendingWrite& Write)
+{
+	bool bSuccess = false;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_DaSaveGameWrite);
+		const double StartTime = FPlatformTime::Seconds();
+		bSuccess = DaSaveGameFile::WriteToSlot(Write.Bytes, Write.bCompress, Write.SlotName, Write.SlotIndex);
+		LastWriteMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+	FinishWrite(Write, bSuccess);
+}
+
+void UDaSaveGameSubsystem::StartNextWrite()
+{
+	if (PendingWrites.Num() == 0)
+	{
+		return;
+	}
+
+	// Everything but the bytes stays here for FinishWrite, the bytes go to the worker
+	TArray<uint8> Bytes = MoveTemp(PendingWrites[0].Bytes);
+	InFlightWrite = MoveTemp(PendingWrites[0]);
+	PendingWrites.RemoveAt(0);
+	bWriteInFlight = true;
+	const uint32 Serial = ++InFlightSerial;
+
+	TWeakObjectPtr<UDaSaveGameSubsystem> WeakThis(this);
+	InFlightTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Serial, Bytes = MoveTemp(Bytes), bCompress = InFlightWrite.bCompress,
+		SlotName = InFlightWrite.SlotName, SlotIndex = InFlightWrite.SlotIndex, SaveObject = InFlightWrite.SaveObject]()
+	{
+		FWriteResult Result;
+		{
+			SCOPE_CYCLE_COUNTER(STAT_DaSaveGameWrite);
+			const double StartTime = FPlatformTime::Seconds();
+			Result.bSuccess = DaSaveGameFile::WriteToSlot(Bytes, bCompress, SlotName, SlotIndex);
+			Result.WriteMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, SaveObject, Result]()
+		{
+			if (UDaSaveGameSubsystem* Subsystem = WeakThis.Get())
+			{
+				Subsystem->OnAsyncWriteFinished(Serial, SaveObject, Result.bSuccess, Result.WriteMs);
+			}
+		});
+
+		// Also returned, for FlushWrites to report the write when it waits on the task
+		return Result;
+	});
+}
+
+void UDaSaveGameSubsystem::OnAsyncWriteFinished(uint32 Serial, TWeakObjectPtr<USaveGame> SaveObject, bool bSuccess, float WriteMs)
+{
+	if (!bWriteInFlight || Serial != InFlightSerial)
+	{
+		// Already accounted for by FlushWrites
+		return;
+	}
+
+	const FPendingWrite Landed = MoveTemp(InFlightWrite);
+	bWriteInFlight = false;
+	InFlightWrite = FPendingWrite();
+	InFlightTask = UE::Tasks::TTask<FWriteResult>();
+	LastWriteMs = WriteMs;
+
+	FinishWrite(Landed, bSuccess);
+	StartNextWrite();
+}
+
+void UDaSaveGameSubsystem::FinishWrite(const FPendingWrite& Write, bool bSuccess)
+{
+	if (!Write.ShardMapName.IsEmpty())
+	{
+		FinishShardWrite(Write, bSuccess);
+	}
+
+	// Map shards are part of the save the main slot write reports on
+	USaveGame* SaveObject = Write.SaveObject.Get();
+	UDaSaveGame* SaveGame = Cast<UDaSaveGame>(SaveObject);
+	if (bSuccess)
+	{
+		// The main save on disk now points at the newer shards
+		for (const FString& ShardSlot : Write.SupersededShardSlots)
+		{
+			if (UGameplayStatics::DoesSaveGameExist(ShardSlot, Write.SlotIndex))
+			{
+				UGameplayStatics::DeleteGameInSlot(ShardSlot, Write.SlotIndex);
+			}
+		}
+
+		if (SaveGame)
+		{
+			LOG("SaveGame written (snapshot %.2f ms, write %.2f ms).", LastSnapshotMs, LastWriteMs);
+			OnSaveGameWritten.Broadcast(SaveGame);
+		}
+	}
+	else
+	{
+		LOG_ERROR("Failed to write %s to disk.", *GetNameSafe(SaveObject));
+
+		// The main save on disk may still point at these; retire them with the next one that lands
+		for (const FString& ShardSlot : Write.SupersededShardSlots)
+		{
+			SupersededShardSlots.AddUnique(ShardSlot);
+		}
+	}
+
+	if (SaveGame)
+	{
+		OnSaveGameWriteCompleted.Broadcast(SaveGame, bSuccess);
+	}
+}
+
+void UDaSaveGameSubsystem::FinishShardWrite(const FPendingWrite& Write, bool bSuccess)
+{
+	if (bSuccess)
+	{
+		// The generation it replaces goes once a main save pointing at this one is on disk too
+		const FString& Replaced = Write.PreviousShardEntry.ShardSlotName;
+		if (!Replaced.IsEmpty())
+		{
+			FPendingWrite* Dependent = PendingWrites.FindByPredicate([&](const FPendingWrite& Pending)
+			{
+				return Pending.SlotIndex == Write.SlotIndex && Pending.RequiredShardSlots.Contains(Write.SlotName);
+			});
+			(Dependent ? Dependent->SupersededShardSlots : SupersededShardSlots).AddUnique(Replaced);
+		}
+		return;
+	}
+
+	// Point the manifest back at the generation still on disk, unless a later shard already replaced this one
+	UDaSaveGame* Owner = Write.ManifestOwner.Get();
+	const FDaSavedMapManifestEntry* Entry = Owner ? Owner->FindMapManifestEntry(Write.ShardMapName) : nullptr;
+	if (Entry && Entry->ShardSlotName == Write.SlotName)
+	{
+		if (Write.PreviousShardEntry.ShardSlotName.IsEmpty())
+		{
+			Owner->MapManifest.RemoveAll([&](const FDaSavedMapManifestEntry& Other) { return Other.MapAssetName == Write.ShardMapName; });
+		}
+		else
+		{
+			Owner->FindOrAddMapManifestEntry(Write.ShardMapName) = Write.PreviousShardEntry;
+		}
+	}
+
+	if (UGameplayStatics::DoesSaveGameExist(Write.SlotName, Write.SlotIndex))
+	{
+		UGameplayStatics::DeleteGameInSlot(Write.SlotName, Write.SlotIndex);
+	}
+
+	// Main saves snapshotted against the missing shard must not land; the one on disk still matches the old shard
+	TArray<FPendingWrite> Dropped;
+	for (int32 i = PendingWrites.Num() - 1; i >= 0; i--)
+	{
+		if (PendingWrites[i].SlotIndex == Write.SlotIndex && PendingWrites[i].RequiredShardSlots.Contains(Write.SlotName))
+		{
+			Dropped.Add(MoveTemp(PendingWrites[i]));
+			PendingWrites.RemoveAt(i);
+		}
+	}
+
+	if (CurrentMapShard && CurrentMapShard->Map.MapAssetName == Write.ShardMapName)
+	{
+		bCurrentMapShardDirty = true;
+	}
+
+	for (const FPendingWrite& Main : Dropped)
+	{
+		LOG_WARNING("Dropping write of '%s': its map shard '%s' failed to write.", *Main.SlotName, *Write.SlotName);
+		FinishWrite(Main, false);
+	}
+}
+
+void UDaSaveGameSubsystem::FlushWrites()
+{
+	// Looped: FinishWrite listeners may save again, which can queue or even launch another write
+	while (bWriteInFlight || PendingWrites.Num() > 0)
+	{
+		if (bWriteInFlight)
+		{
+			// Writes to the same slot must land in order, so the queued ones wait for this one.
+			// Reported here: clearing bWriteInFlight turns the task's game thread callback into a no-op.
+			const FWriteResult Result = InFlightTask.GetResult();
+			const FPendingWrite Landed = MoveTemp(InFlightWrite);
+			bWriteInFlight = false;
+			InFlightWrite = FPendingWrite();
+			InFlightTask = UE::Tasks::TTask<FWriteResult>();
+			LastWriteMs = Result.WriteMs;
+			FinishWrite(Landed, Result.bSuccess);
+			continue;
+		}
+
+		const FPendingWrite Write = MoveTemp(PendingWrites[0]);
+		PendingWrites.RemoveAt(0);
+		WriteNow(Write);
+	}
+}
+
+bool UDaSaveGameSubsystem::IsSlotUnwritten(const FString& SlotName, int32 SlotIndex) const
+{
+	auto IsSlot = [&](const FPendingWrite& Pending) { return Pending.SlotIndex == SlotIndex && Pending.SlotName == SlotName; };
+	return (bWriteInFlight && IsSlot(InFlightWrite)) || PendingWrites.ContainsByPredicate(IsSlot);
+}
+
+USaveGame* UDaSaveGameSubsystem::FindUnwrittenSave(const FString& SlotName, int32 SlotIndex) const
+{
+	// Newest first: the queue is written after the in-flight write
+	for (int32 i = PendingWrites.Num() - 1; i >= 0; i--)
+	{
+		const FPendingWrite& Pending = PendingWrites[i];
+		if (Pending.SlotIndex == SlotIndex && Pending.SlotName == SlotName)
+		{
+			return Pending.SaveObject.Get();
+		}
+	}
+
+	if (bWriteInFlight && InFlightWrite.SlotIndex == SlotIndex && InFlightWrite.SlotName == SlotName)
+	{
+		return InFlightWrite.SaveObject.Get();
+	}
+	return nullptr;
 }
 
 void UDaSaveGameSubsystem::HandleStartingNewPlayer(AController* NewPlayer)
@@ -183,9 +631,10 @@ void UDaSaveGameSubsystem::WriteSaveGame()
 		return;
 	}
 
-	// Clear arrays, may contain data from previously loaded SaveGame
-	CurrentSaveGame->SavedPlayers.Empty();
+	// SavedPlayers is kept: players who are not connected right now keep their entry, connected ones
+	// overwrite theirs. Actor records go to the current map's shard, never the main save.
 	CurrentSaveGame->SavedActors.Empty();
+	CurrentSaveGame->ActorSaveRecordVersion = EDaActorSaveRecordVersion::Latest;
 
 	AGameStateBase* GS = GetWorld()->GetGameState();
 	if (GS == nullptr)
@@ -194,52 +643,43 @@ void UDaSaveGameSubsystem::WriteSaveGame()
 		return;
 	}
 
-	// Iterate all player states, we don't have proper ID to match yet (requires Steam or EOS)
+	// Every connected player; each one updates its own entry through the PlayerID index
 	for (int32 i = 0; i < GS->PlayerArray.Num(); i++)
 	{
 		ADaPlayerState* PS = Cast<ADaPlayerState>(GS->PlayerArray[i]);
 		if (PS)
 		{
 			PS->SavePlayerState(CurrentSaveGame);
-			break; // single player only at this point
 		}
 	}
 
-	// Iterate the entire world of actors
-	for (FActorIterator It(GetWorld()); It; ++It)
+	// The live actors are the whole state of this map, so a shard from another map (no load happened
+	// here) is replaced rather than merged
+	const FString MapAssetName = GetCurrentMapAssetName();
+	if (CurrentMapShard == nullptr || CurrentMapShard->Map.MapAssetName != MapAssetName)
 	{
-		AActor* Actor = *It;
-		
-		// Only interested in our 'actors with a saveable interface', skip actors that are being destroyed
-		if (Actor->IsPendingKillPending() || !Actor->Implements<UDaSaveInterface>())
-		{
-			continue;
-		}
-
-		FActorSaveData ActorData;
-		ActorData.ActorName = Actor->GetFName();
-		ActorData.Transform = Actor->GetActorTransform();
-
-		// Pass the array to fill with data from Actor
-		FMemoryWriter MemWriter(ActorData.ByteData);
-
-		FObjectAndNameAsStringProxyArchive Ar(MemWriter, true);
-		// Find only variables with UPROPERTY(SaveGame)
-		Ar.ArIsSaveGame = true;
-		// Converts Actor's SaveGame UPROPERTIES into binary array
-		Actor->Serialize(Ar);
+		CurrentMapShard = MakeMapShard(MapAssetName);
+	}
+	CurrentMapShard->Map.SavedActors.Reset();
 
-		CurrentSaveGame->SavedActors.Add(ActorData);
+	// Saveable actors come from the registry, only the ones marked dirty since the last save are re-serialized
+	if (UDaSaveActorRegistrySubsystem* Registry = UDaSaveActorRegistrySubsystem::Get(this))
+	{
+		Registry->GatherSaveRecords(CurrentMapShard->Map.SavedActors);
 	}
+	bCurrentMapShardDirty = true;
 }
 
 void UDaSaveGameSubsystem::LoadSaveGame(FString InSlotName, int32 SlotIndex)
 {
 	// Update slot name first if specified, otherwise keeps default name
 
+	// Read what the last save actually put on disk
+	FlushWrites();
+
 	if (UGameplayStatics::DoesSaveGameExist(InSlotName, SlotIndex))
 	{
-		CurrentSaveGame = Cast<UDaSaveGame>(UGameplayStatics::LoadGameFromSlot(InSlotName, SlotIndex));
+		CurrentSaveGame = Cast<UDaSaveGame>(DaSaveGameFile::LoadFromSlot(InSlotName, SlotIndex));
 		if (CurrentSaveGame == nullptr)
 		{
 			LOG("Failed to load SaveGame Data.");
@@ -248,35 +688,67 @@ void UDaSaveGameSubsystem::LoadSaveGame(FString InSlotName, int32 SlotIndex)
 
 		LOG("Loaded SaveGame Data.");
 		
-		// Iterate the entire world of actors
-		for (FActorIterator It(GetWorld()); It; ++It)
+		const int32 RecordVersion = CurrentSaveGame->ActorSaveRecordVersion;
+		if (RecordVersion > EDaActorSaveRecordVersion::Latest)
 		{
-			AActor* Actor = *It;
-			
-			// Only interested in our 'gameplay actors'
-			if (!Actor->Implements<UDaSaveInterface>())
+			LOG_WARNING("SaveGame actor records are version %d, newer than supported %d. Skipping actor restore.", RecordVersion, (int32)EDaActorSaveRecordVersion::Latest);
+		}
+		else
+		{
+			// Only this map's records are read; older saves are split into shards first
+			const FString MapAssetName = GetCurrentMapAssetName();
+			CurrentMapShard = nullptr;
+			bCurrentMapShardDirty = false;
+			if (MigrateMonolithicSave(InSlotName, SlotIndex))
 			{
-				continue;
+				// Persist the shards and manifest now, before a later load could attribute the legacy records to another map
+				CommitToSlot(InSlotName, SlotIndex);
+			}
+			if (CurrentMapShard == nullptr)
+			{
+				CurrentMapShard = LoadMapShard(InSlotName, SlotIndex, MapAssetName);
+			}
+			if (CurrentMapShard == nullptr)
+			{
+				CurrentMapShard = MakeMapShard(MapAssetName);
 			}
 
-			for (FActorSaveData ActorData : CurrentSaveGame->SavedActors)
+			// Index the records once, each saveable actor then finds its own in O(1)
+			FDaActorSaveIndex ActorIndex;
+			const int32 NumDuplicates = ActorIndex.Build(CurrentMapShard->Map.SavedActors);
+			if (NumDuplicates > 0)
 			{
-				if (ActorData.ActorName == Actor->GetFName())
+				LOG_WARNING("SaveGame (actor record version %d) has %d duplicate actor name(s); using the last record for each.", RecordVersion, NumDuplicates);
+			}
+
+			UDaSaveActorRegistrySubsystem* Registry = UDaSaveActorRegistrySubsystem::Get(this);
+			if (Registry)
+			{
+				Registry->ForEachSaveActor([&ActorIndex](AActor& Actor)
 				{
-					if (IDaSaveInterface::Execute_ShouldLoadTransform(Actor))
+					const FActorSaveData* ActorData = ActorIndex.Find(Actor.GetFName());
+					if (ActorData == nullptr)
+					{
+						return;
+					}
+
+					if (IDaSaveInterface::Execute_ShouldLoadTransform(&Actor))
 					{
-						Actor->SetActorTransform(ActorData.Transform);
+						Actor.SetActorTransform(ActorData->Transform);
 					}
 					
-					FMemoryReader MemReader(ActorData.ByteData);
+					FMemoryReader MemReader(ActorData->ByteData);
 
 					FObjectAndNameAsStringProxyArchive Ar(MemReader, true);
 					Ar.ArIsSaveGame = true;
 					// Convert binary array back into actor's variables
-					Actor->Serialize(Ar);
+					Actor.Serialize(Ar);
 
-					IDaSaveInterface::Execute_LoadActor(Actor);
-				}
+					IDaSaveInterface::Execute_LoadActor(&Actor);
+				});
+
+				// Loading rewrote their SaveGame properties, the cached records are stale
+				Registry->MarkAllSaveDirty();
 			}
 		}
 
@@ -291,5 +763,139 @@ void UDaSaveGameSubsystem::LoadSaveGame(FString InSlotName, int32 SlotIndex)
 			SaveGameClass = GI->SaveGameClass;
 		} 
 		CurrentSaveGame = Cast<UDaSaveGame>(UGameplayStatics::CreateSaveGameObject(SaveGameClass));
+		CurrentMapShard = MakeMapShard(GetCurrentMapAssetName());
+		bCurrentMapShardDirty = false;
+	}
+}
+
+const FSavedMap* UDaSaveGameSubsystem::GetCurrentSavedMap() const
+{
+	return CurrentMapShard ? &CurrentMapShard->Map : nullptr;
+}
+
+bool UDaSaveGameSubsystem::LoadSavedMap(const FString& InMapName, FSavedMap& OutMap)
+{
+	if (CurrentSaveGame == nullptr)
+	{
+		return false;
+	}
+
+	if (CurrentMapShard && CurrentMapShard->Map.MapAssetName == InMapName)
+	{
+		OutMap = CurrentMapShard->Map;
+		return true;
+	}
+
+	// Not migrated yet: the records are still in the main save
+	if (const FSavedMap* Legacy = CurrentSaveGame->SavedMaps.FindByPredicate([&](const FSavedMap& Map) { return Map.MapAssetName == InMapName; }))
+	{
+		OutMap = *Legacy;
+		return true;
+	}
+
+	// Shards on disk trail whatever is still queued for them
+	FlushWrites();
+
+	const UDaGameInstanceBase* GI = Cast<UDaGameInstanceBase>(GetGameInstance());
+	const UDaSavedMapShard* Shard = GI ? LoadMapShard(GI->LoadSlotName, GI->LoadSlotIndex, InMapName) : nullptr;
+	if (Shard == nullptr)
+	{
+		return false;
+	}
+	OutMap = Shard->Map;
+	return true;
+}
+
+FString UDaSaveGameSubsystem::GetCurrentMapAssetName() const
+{
+	const UWorld* World = GetWorld();
+	return World ? UWorld::RemovePIEPrefix(World->GetPackage()->GetName()) : FString();
+}
+
+UDaSavedMapShard* UDaSaveGameSubsystem::MakeMapShard(const FString& InMapName)
+{
+	UDaSavedMapShard* Shard = NewObject<UDaSavedMapShard>(this);
+	Shard->Map.MapAssetName = InMapName;
+	return Shard;
+}
+
+UDaSavedMapShard* UDaSaveGameSubsystem::LoadMapShard(const FString& SlotName, int32 SlotIndex, const FString& InMapName)
+{
+	const FDaSavedMapManifestEntry* Entry = CurrentSaveGame ? CurrentSaveGame->FindMapManifestEntry(InMapName) : nullptr;
+	if (Entry == nullptr)
+	{
+		// Never saved on this map
+		return nullptr;
+	}
+
+	TArray<uint8> Raw;
+	if (!DaSaveGameFile::LoadRawFromSlot(Entry->ShardSlotName, SlotIndex, Raw))
+	{
+		LOG_ERROR("SaveGame '%s' lists map '%s' but its shard '%s' could not be read. Skipping actor restore.", *SlotName, *InMapName, *Entry->ShardSlotName);
+		return nullptr;
+	}
+
+	// A shard from an interrupted save (or a different save in the same slot) must not be applied
+	const uint32 Checksum = FCrc::MemCrc32(Raw.GetData(), Raw.Num());
+	if (Checksum != Entry->Checksum)
+	{
+		LOG_ERROR("SaveGame shard '%s' for map '%s' fails its checksum (%08X, manifest %08X). Skipping actor restore.", *Entry->ShardSlotName, *InMapName, Checksum, Entry->Checksum);
+		return nullptr;
+	}
+
+	UDaSavedMapShard* Shard = Cast<UDaSavedMapShard>(UGameplayStatics::LoadGameFromMemory(Raw));
+	if (Shard == nullptr || Shard->Map.MapAssetName != InMapName)
+	{
+		LOG_ERROR("SaveGame shard '%s' does not hold map '%s'. Skipping actor restore.", *Entry->ShardSlotName, *InMapName);
+		return nullptr;
+	}
+	return Shard;
+}
+
+bool UDaSaveGameSubsystem::MigrateMonolithicSave(const FString& SlotName, int32 SlotIndex)
+{
+	if (CurrentSaveGame->ActorSaveRecordVersion >= EDaActorSaveRecordVersion::MapSharded
+		|| (CurrentSaveGame->SavedActors.Num() == 0 && CurrentSaveGame->SavedMaps.Num() == 0))
+	{
+		return false;
+	}
+
+	const FString MapAssetName = GetCurrentMapAssetName();
+	LOG("Migrating SaveGame '%s' (actor record version %d) to per-map shards.", *SlotName, CurrentSaveGame->ActorSaveRecordVersion);
+
+	// Per-map data of the old format goes to its own shard
+	for (FSavedMap& Map : CurrentSaveGame->SavedMaps)
+	{
+		if (Map.MapAssetName.IsEmpty())
+		{
+			continue;
+		}
+
+		UDaSavedMapShard* Shard = MakeMapShard(Map.MapAssetName);
+		Shard->Map.SavedActors = MoveTemp(Map.SavedActors);
+		if (Map.MapAssetName == MapAssetName)
+		{
+			CurrentMapShard = Shard;
+		}
+		else
+		{
+			QueueShardWrite(Shard, SlotName, SlotIndex);
+		}
 	}
+
+	// The top-level records were applied to whatever map was loaded, which is this one
+	if (CurrentSaveGame->SavedActors.Num() > 0)
+	{
+		if (CurrentMapShard == nullptr)
+		{
+			CurrentMapShard = MakeMapShard(MapAssetName);
+		}
+		CurrentMapShard->Map.SavedActors = MoveTemp(CurrentSaveGame->SavedActors);
+	}
+	bCurrentMapShardDirty = CurrentMapShard != nullptr;
+
+	CurrentSaveGame->SavedMaps.Empty();
+	CurrentSaveGame->SavedActors.Empty();
+	CurrentSaveGame->ActorSaveRecordVersion = EDaActorSaveRecordVersion::Latest;
+	return true;
 }
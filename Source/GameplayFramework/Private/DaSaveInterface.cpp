@@ -5,3 +5,8 @@
 
 
 // Add default functionality here for any IDaSaveInterface functions that are not pure virtual.
+
+bool IDaSaveInterface::SupportsSaveDirtyTracking_Implementation()
+{
+	return false;
+}
@@ -0,0 +1,25 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "DaSimulatedImpactRelay.h"
+
+#include "DaProjectile.h"
+
+ADaSimulatedImpactRelay::ADaSimulatedImpactRelay()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	SetReplicatingMovement(false);
+}
+
+void ADaSimulatedImpactRelay::MulticastImpactCosmetics_Implementation(const TArray<FDaSimulatedImpactCosmetic>& Impacts)
+{
+	for (const FDaSimulatedImpactCosmetic& Impact : Impacts)
+	{
+		if (const UClass* Class = Impact.Class.Get())
+		{
+			Class->GetDefaultObject<ADaProjectile>()->PlayImpactCosmetics(this, Impact.Location);
+		}
+	}
+}
@@ -3,6 +3,10 @@
 
 #include "DaState.h"
 
+#if WITH_EDITOR
+uint32 UDaState::EditGeneration = 0;
+#endif
+
 UDaState* UDaBranch::TryBranch(const UObject* RefObject, const TArray<UDaInputAtom*>& DataSource, int32 DataIndex,
 	int32& OutDataIndex)
 {
@@ -14,11 +18,129 @@ UDaState* UDaBranch::TryBranch(const UObject* RefObject, const TArray<UDaInputAt
 	return bReverseInputTest ? DestinationState : nullptr;
 }
 
+#if WITH_EDITOR
+void UDaBranch::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	++UDaState::EditGeneration;
+}
+#endif
+
 UDaState::UDaState()
 {
 	bLoopByDefault = true;
 }
 
+#if WITH_EDITOR
+void UDaState::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	++EditGeneration;
+}
+#endif
+
+bool UDaState::CompileTransitionTable(FDaStateTransitionTable& OutTable) const
+{
+	OutTable.States.Reset();
+
+	TMap<const UDaState*, int32> StateIndices;
+	auto IndexOfState = [&OutTable, &StateIndices](const UDaState* State)
+	{
+		if (const int32* Found = StateIndices.Find(State))
+		{
+			return *Found;
+		}
+		const int32 NewIndex = OutTable.States.AddDefaulted();
+		OutTable.States[NewIndex].State = State;
+		StateIndices.Add(State, NewIndex);
+		return NewIndex;
+	};
+
+	IndexOfState(this);
+
+	// States are appended as they are discovered, so this walks everything reachable from the root
+	for (int32 RowIndex = 0; RowIndex < OutTable.States.Num(); ++RowIndex)
+	{
+		const UDaState* State = OutTable.States[RowIndex].State;
+		if (State->GetClass() != UDaState::StaticClass())
+		{
+			// A subclass may override RunState, which the table would bypass
+			OutTable.States.Reset();
+			return false;
+		}
+
+		// Same priority order RunState tries them in
+		TArray<const UDaBranch*, TInlineAllocator<8>> Branches;
+		for (const UDaBranch* Branch : State->InstancedBranches)
+		{
+			if (Branch)
+			{
+				Branches.Add(Branch);
+			}
+		}
+		for (const UDaBranch* Branch : State->SharedBranches)
+		{
+			if (Branch)
+			{
+				Branches.Add(Branch);
+			}
+		}
+
+		TSet<const UDaInputAtom*> ListedInputs;
+		for (const UDaBranch* Branch : Branches)
+		{
+			if (Branch->GetClass() != UDaBranch::StaticClass())
+			{
+				// A subclass may decide on RefObject or read several inputs at once
+				OutTable.States.Reset();
+				return false;
+			}
+			for (const UDaInputAtom* Input : Branch->GetAcceptableInputs())
+			{
+				ListedInputs.Add(Input);
+			}
+		}
+
+		// What RunState does with an input no branch takes
+		const int32 NoBranch = State->bLoopByDefault ? FDaStateTransitionTable::Loop : FDaStateTransitionTable::Halt;
+
+		// First branch taken for an input with the given membership, mirroring UDaBranch::TryBranch
+		auto Resolve = [&Branches, &IndexOfState, NoBranch](const UDaInputAtom* Input, bool bUnlisted)
+		{
+			for (const UDaBranch* Branch : Branches)
+			{
+				const bool bContains = !bUnlisted && Branch->GetAcceptableInputs().Contains(Input);
+				UDaState* Destination = (bContains != Branch->IsReverseInputTest()) ? Branch->GetDestinationState() : nullptr;
+				if (Destination)
+				{
+					return IndexOfState(Destination);
+				}
+			}
+			return NoBranch;
+		};
+
+		// Resolve may grow States, so the row is re-fetched after each call rather than held
+		const int32 DefaultTransition = Resolve(nullptr, true);
+		TMap<const UDaInputAtom*, int32> Transitions;
+		for (const UDaInputAtom* Input : ListedInputs)
+		{
+			const int32 Next = Resolve(Input, false);
+			if (Next != DefaultTransition)
+			{
+				Transitions.Add(Input, Next);
+			}
+		}
+
+		FDaStateTransitionTable::FStateRow& Row = OutTable.States[RowIndex];
+		Row.CompletionType = State->CompletionType;
+		Row.bTerminal = State->bTerminateImmediatly;
+		Row.DefaultTransition = DefaultTransition;
+		Row.Transitions = MoveTemp(Transitions);
+	}
+
+	return true;
+}
+
 FStateMachineResult UDaState::RunState(const UObject* RefObject, const TArray<UDaInputAtom*>& DataSource,
 	int32 DataIndex, int32 RemainingSteps)
 {
@@ -18,9 +18,9 @@ ADaTeleportProjectile::ADaTeleportProjectile()
 	MovementComp->InitialSpeed = 6000.f;
 }
 
-void ADaTeleportProjectile::BeginPlay()
+void ADaTeleportProjectile::StartFlight()
 {
-	Super::BeginPlay();
+	Super::StartFlight();
 
 	GetWorldTimerManager().SetTimer(TimerHandle_DelayedDetonate, this, &ADaTeleportProjectile::Explode, DetonateDelay);
 }
@@ -64,8 +64,8 @@ void ADaTeleportProjectile::TeleportInstigator()
 		PC->ClientStartCameraShake(ImpactShake);
 	}
 
-	// Now we're ready to destroy self
-	Destroy();
+	// Now we're ready to go back to the pool
+	ReleaseToPool();
 }
 
 
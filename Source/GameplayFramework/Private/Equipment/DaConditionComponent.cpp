@@ -3,7 +3,6 @@
 #include "Equipment/DaConditionComponent.h"
 
 #include "CoreGameplayTags.h"
-#include "Engine/AssetManager.h"
 #include "Engine/World.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerState.h"
@@ -15,6 +14,7 @@
 #include "Inventory/DaInventoryComponent.h"
 #include "Inventory/DaInventoryEntry.h"
 #include "Inventory/DaItemDefinition.h"
+#include "Inventory/DaItemDefinitionCache.h"
 #include "TimerManager.h"
 
 const FName UDaConditionComponent::WearIntensityParameterName(TEXT("Da_Wear_Intensity"));
@@ -257,16 +257,7 @@ UDaInventoryComponent* UDaConditionComponent::ResolveInventory() const
 
 UDaItemDefinition* UDaConditionComponent::ResolveItemDefinition(FPrimaryAssetId ItemDefinitionID) const
 {
-	if (!ItemDefinitionID.IsValid())
-	{
-		return nullptr;
-	}
-	if (UDaItemDefinition* Loaded = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(ItemDefinitionID)))
-	{
-		return Loaded;
-	}
-	const FSoftObjectPath Path = UAssetManager::Get().GetPrimaryAssetPath(ItemDefinitionID);
-	return Cast<UDaItemDefinition>(Path.TryLoad());
+	return UDaItemDefinitionCache::ResolveDefinitionBlocking(this, ItemDefinitionID);
 }
 
 // ---------------------------------------------------------------------------
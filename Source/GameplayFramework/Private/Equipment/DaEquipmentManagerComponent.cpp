@@ -18,6 +18,7 @@
 #include "Inventory/DaInventoryComponent.h"
 #include "Inventory/DaInventoryEntry.h"
 #include "Inventory/DaItemDefinition.h"
+#include "Inventory/DaItemDefinitionCache.h"
 #include "TimerManager.h"
 
 UDaEquipmentManagerComponent::UDaEquipmentManagerComponent()
@@ -317,11 +318,7 @@ bool UDaEquipmentManagerComponent::ActivateItemSlotForPawn(APawn* Pawn, FGamepla
 	const FPrimaryAssetId DefinitionID = Entry->ItemDefinitionID;
 	const int32 SlotIndex = Entry->SlotIndex;
 
-	UDaItemDefinition* Def = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(DefinitionID));
-	if (!Def)
-	{
-		Def = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetPath(DefinitionID).TryLoad());
-	}
+	UDaItemDefinition* Def = ResolveItemDefinition(DefinitionID);
 	if (!Def)
 	{
 		return false;
@@ -952,14 +949,5 @@ UDaAbilitySystemComponent* UDaEquipmentManagerComponent::ResolveASC() const
 
 UDaItemDefinition* UDaEquipmentManagerComponent::ResolveItemDefinition(FPrimaryAssetId ItemDefinitionID) const
 {
-	if (!ItemDefinitionID.IsValid())
-	{
-		return nullptr;
-	}
-	if (UDaItemDefinition* Loaded = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(ItemDefinitionID)))
-	{
-		return Loaded;
-	}
-	const FSoftObjectPath Path = UAssetManager::Get().GetPrimaryAssetPath(ItemDefinitionID);
-	return Cast<UDaItemDefinition>(Path.TryLoad());
+	return UDaItemDefinitionCache::ResolveDefinitionBlocking(this, ItemDefinitionID);
 }
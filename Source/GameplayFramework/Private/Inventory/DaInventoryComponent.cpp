@@ -5,15 +5,15 @@
 #include "AbilitySystem/DaAbilitySet.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "CoreGameplayTags.h"
-#include "DaItemActor.h"
 #include "DaPlayerState.h"
 #include "GameplayFramework.h"
-#include "Engine/AssetManager.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerState.h"
 #include "Inventory/DaInventoryItemBase.h"
 #include "Inventory/DaInventoryList.h"
 #include "Inventory/DaItemDefinition.h"
+#include "Inventory/DaItemDefinitionCache.h"
+#include "Inventory/DaItemDropSubsystem.h"
 #include "Net/UnrealNetwork.h"
 
 namespace
@@ -22,6 +22,7 @@ namespace
 	// entry's stat array or the loadout without limit.
 	constexpr int32 MaxStatTagsPerEntry = 32;
 	constexpr int32 MaxLoadoutEntries = 16;
+	constexpr int32 MaxBatchOps = 64;
 
 	/**
 	 * Slack on the repair cost before rounding up. The cost curve is authored as floats, so a
@@ -63,6 +64,21 @@ void UDaInventoryComponent::BeginPlay()
 	Super::BeginPlay();
 
 	InventoryList.OwnerComponent = this; // belt and braces; the constructor already set it
+	InventoryList.SetSlotCapacity(MaxSlots);
+}
+
+void UDaInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Hand back the cache references our entries took through OnEntryAddedInternal.
+	if (UDaItemDefinitionCache* Cache = UDaItemDefinitionCache::Get(this))
+	{
+		for (const FDaInventoryEntry& Entry : InventoryList.GetEntries())
+		{
+			Cache->RemoveHeldReference(Entry.ItemDefinitionID);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UDaInventoryComponent::GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const
@@ -100,23 +116,7 @@ bool UDaInventoryComponent::RemoveItem(int32 SlotIndex, int32 Count)
 
 	if (GetOwnerRole() == ROLE_Authority)
 	{
-		const FDaInventoryEntry* Entry = InventoryList.FindBySlot(SlotIndex);
-		if (!Entry)
-		{
-			return false;
-		}
-
-		if (Count == 0 || Count >= Entry->StackCount)
-		{
-			InventoryList.RemoveEntry(SlotIndex);
-		}
-		else
-		{
-			FDaInventoryEntry Updated = *Entry;
-			Updated.StackCount -= Count;
-			InventoryList.UpdateEntry(SlotIndex, Updated);
-		}
-		return true;
+		return Internal_RemoveItem(SlotIndex, Count);
 	}
 
 	// Client: route to server RPC
@@ -133,31 +133,7 @@ bool UDaInventoryComponent::MoveItem(int32 FromSlot, int32 ToSlot)
 
 	if (GetOwnerRole() == ROLE_Authority)
 	{
-		const FDaInventoryEntry* FromEntry = InventoryList.FindBySlot(FromSlot);
-		if (!FromEntry)
-		{
-			return false;
-		}
-
-		const FDaInventoryEntry* ToEntry = InventoryList.FindBySlot(ToSlot);
-		if (ToEntry)
-		{
-			// Swap: update both entries with swapped slot indices
-			FDaInventoryEntry UpdatedFrom = *FromEntry;
-			FDaInventoryEntry UpdatedTo = *ToEntry;
-			UpdatedFrom.SlotIndex = ToSlot;
-			UpdatedTo.SlotIndex = FromSlot;
-			InventoryList.UpdateEntry(FromSlot, UpdatedTo);
-			InventoryList.UpdateEntry(ToSlot, UpdatedFrom);
-		}
-		else
-		{
-			// Move: update slot index in-place to preserve FastArray identity (change delta, not remove/add)
-			FDaInventoryEntry Updated = *FromEntry;
-			Updated.SlotIndex = ToSlot;
-			InventoryList.UpdateEntry(FromSlot, Updated);
-		}
-		return true;
+		return Internal_MoveItem(FromSlot, ToSlot);
 	}
 
 	// Client: route to server RPC
@@ -194,6 +170,19 @@ bool UDaInventoryComponent::DropItem(int32 SlotIndex, int32 Count)
 	return true;
 }
 
+bool UDaInventoryComponent::ApplyInventoryBatch(const TArray<FDaInventoryOp>& Ops)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		return Internal_ApplyInventoryBatch(Ops);
+	}
+
+	// Client: one reliable RPC for the whole batch (optimistic return; the server validates
+	// and reports through OnInventoryBatchApplied)
+	Server_ApplyInventoryBatch(Ops);
+	return true;
+}
+
 TArray<FDaInventoryEntry> UDaInventoryComponent::GetAllEntries() const
 {
 	return InventoryList.GetEntries();
@@ -206,7 +195,7 @@ TArray<UDaInventoryItemBase*> UDaInventoryComponent::GetItems()
 	Result.Reserve(Entries.Num());
 	for (const FDaInventoryEntry& Entry : Entries)
 	{
-		if (UDaInventoryItemBase* Item = UDaInventoryItemBase::CreateFromEntry(Entry, this))
+		if (UDaInventoryItemBase* Item = FindOrCreateItemViewModel(Entry))
 		{
 			Result.Add(Item);
 		}
@@ -214,6 +203,27 @@ TArray<UDaInventoryItemBase*> UDaInventoryComponent::GetItems()
 	return Result;
 }
 
+UDaInventoryItemBase* UDaInventoryComponent::FindOrCreateItemViewModel(const FDaInventoryEntry& Entry)
+{
+	if (!Entry.ItemID.IsValid())
+	{
+		return nullptr;
+	}
+
+	TObjectPtr<UDaInventoryItemBase>& Item = ItemViewModels.FindOrAdd(Entry.ItemID);
+	if (!Item)
+	{
+		Item = UDaInventoryItemBase::CreateFromEntry(Entry, this);
+	}
+	return Item;
+}
+
+UDaInventoryItemBase* UDaInventoryComponent::FindItemViewModel(FGuid ItemID) const
+{
+	const TObjectPtr<UDaInventoryItemBase>* Found = ItemViewModels.Find(ItemID);
+	return Found ? Found->Get() : nullptr;
+}
+
 const FDaInventoryEntry* UDaInventoryComponent::GetEntryAtSlot(int32 SlotIndex) const
 {
 	return InventoryList.FindBySlot(SlotIndex);
@@ -221,7 +231,7 @@ const FDaInventoryEntry* UDaInventoryComponent::GetEntryAtSlot(int32 SlotIndex)
 
 bool UDaInventoryComponent::IsSlotEmpty(int32 SlotIndex) const
 {
-	return InventoryList.FindBySlot(SlotIndex) == nullptr;
+	return InventoryList.IsSlotEmpty(SlotIndex);
 }
 
 int32 UDaInventoryComponent::GetFilledSlotCount() const
@@ -240,15 +250,7 @@ int32 UDaInventoryComponent::GetMaxSlots() const
 
 const FDaInventoryEntry* UDaInventoryComponent::FindEntryByItemID(const FGuid& ItemID) const
 {
-	for (const FDaInventoryEntry& Entry : InventoryList.Entries)
-	{
-		if (Entry.ItemID == ItemID)
-		{
-			return &Entry;
-		}
-	}
-
-	return nullptr;
+	return InventoryList.FindByItemID(ItemID);
 }
 
 bool UDaInventoryComponent::SetItemStat(FGuid ItemID, FGameplayTag StatTag, int32 Count)
@@ -400,8 +402,7 @@ void UDaInventoryComponent::LoadInventory(const TArray<FDaInventoryEntry>& Saved
 	}
 
 	// Clear existing entries
-	InventoryList.MarkArrayDirty();
-	InventoryList.Entries.Empty();
+	InventoryList.EmptyEntries();
 
 	// Re-add each saved entry
 	for (const FDaInventoryEntry& Entry : SavedEntries)
@@ -512,63 +513,17 @@ void UDaInventoryComponent::Server_AddItem_Implementation(FPrimaryAssetId ItemDe
 
 void UDaInventoryComponent::Server_RemoveItem_Implementation(int32 SlotIndex, int32 Count)
 {
-	if (Count < 0)
-	{
-		LOG_WARNING("Server_RemoveItem: invalid Count %d", Count);
-		return;
-	}
-
-	const FDaInventoryEntry* Entry = InventoryList.FindBySlot(SlotIndex);
-	if (!Entry)
-	{
-		LOG_WARNING("Server_RemoveItem: no entry at slot %d", SlotIndex);
-		return;
-	}
-
-	if (Count == 0 || Count >= Entry->StackCount)
-	{
-		InventoryList.RemoveEntry(SlotIndex);
-	}
-	else
+	if (!Internal_RemoveItem(SlotIndex, Count))
 	{
-		FDaInventoryEntry Updated = *Entry;
-		Updated.StackCount -= Count;
-		InventoryList.UpdateEntry(SlotIndex, Updated);
+		LOG_WARNING("Server_RemoveItem failed for slot %d count %d", SlotIndex, Count);
 	}
 }
 
 void UDaInventoryComponent::Server_MoveItem_Implementation(int32 FromSlot, int32 ToSlot)
 {
-	if (FromSlot < 0 || FromSlot >= MaxSlots || ToSlot < 0 || ToSlot >= MaxSlots || FromSlot == ToSlot)
-	{
-		LOG_WARNING("Server_MoveItem: invalid slot range From=%d To=%d (MaxSlots=%d)", FromSlot, ToSlot, MaxSlots);
-		return;
-	}
-
-	const FDaInventoryEntry* FromEntry = InventoryList.FindBySlot(FromSlot);
-	if (!FromEntry)
+	if (!Internal_MoveItem(FromSlot, ToSlot))
 	{
-		LOG_WARNING("Server_MoveItem: no entry at from-slot %d", FromSlot);
-		return;
-	}
-
-	const FDaInventoryEntry* ToEntry = InventoryList.FindBySlot(ToSlot);
-	if (ToEntry)
-	{
-		// Swap
-		FDaInventoryEntry UpdatedFrom = *FromEntry;
-		FDaInventoryEntry UpdatedTo = *ToEntry;
-		UpdatedFrom.SlotIndex = ToSlot;
-		UpdatedTo.SlotIndex = FromSlot;
-		InventoryList.UpdateEntry(FromSlot, UpdatedTo);
-		InventoryList.UpdateEntry(ToSlot, UpdatedFrom);
-	}
-	else
-	{
-		// Move in-place to preserve FastArray identity
-		FDaInventoryEntry Updated = *FromEntry;
-		Updated.SlotIndex = ToSlot;
-		InventoryList.UpdateEntry(FromSlot, Updated);
+		LOG_WARNING("Server_MoveItem failed From=%d To=%d", FromSlot, ToSlot);
 	}
 }
 
@@ -660,6 +615,14 @@ void UDaInventoryComponent::Server_RepairItem_Implementation(FGuid ItemID, int32
 	}
 }
 
+void UDaInventoryComponent::Server_ApplyInventoryBatch_Implementation(const TArray<FDaInventoryOp>& Ops)
+{
+	if (!Internal_ApplyInventoryBatch(Ops))
+	{
+		LOG_WARNING("Server_ApplyInventoryBatch rolled back a batch of %d op(s)", Ops.Num());
+	}
+}
+
 // ---------------------------------------------------------------------------
 // Client notifications
 // ---------------------------------------------------------------------------
@@ -674,12 +637,22 @@ void UDaInventoryComponent::Client_NotifyItemDropped_Implementation(FDaInventory
 	OnItemDropped.Broadcast(Entry, Entry.SlotIndex);
 }
 
+void UDaInventoryComponent::Client_NotifyInventoryBatchApplied_Implementation(bool bCommitted)
+{
+	OnInventoryBatchApplied.Broadcast(bCommitted);
+}
+
 // ---------------------------------------------------------------------------
 // Internal add logic (server-only)
 // ---------------------------------------------------------------------------
 
-bool UDaInventoryComponent::Internal_AddItem(FPrimaryAssetId ItemDefinitionID, int32 StackCount, int32 SlotHint)
+bool UDaInventoryComponent::Internal_AddItem(FPrimaryAssetId ItemDefinitionID, int32 StackCount, int32 SlotHint, int32* OutAddedCount)
 {
+	if (OutAddedCount)
+	{
+		*OutAddedCount = 0;
+	}
+
 	if (GetOwnerRole() != ROLE_Authority)
 	{
 		return false;
@@ -705,6 +678,16 @@ bool UDaInventoryComponent::Internal_AddItem(FPrimaryAssetId ItemDefinitionID, i
 		return false;
 	}
 
+	// StackCount comes from clients (Server_AddItem, batch Add). More than a full inventory of full
+	// stacks can never be an honest partial add, so refuse it before planning any slots.
+	const int64 Capacity = static_cast<int64>(FMath::Max(MaxSlots, 0)) * FMath::Max(1, Def->MaxStackCount);
+	if (StackCount > Capacity)
+	{
+		LOG_WARNING("Internal_AddItem: StackCount %d of %s exceeds what %d slots can hold (%lld), rejected",
+			StackCount, *ItemDefinitionID.ToString(), MaxSlots, Capacity);
+		return false;
+	}
+
 	int32 Remaining = StackCount;
 
 	// Check if stackable and try to stack with existing entries
@@ -750,6 +733,10 @@ bool UDaInventoryComponent::Internal_AddItem(FPrimaryAssetId ItemDefinitionID, i
 			InventoryList.UpdateEntry(StackSlot, Updated);
 
 			Remaining -= ToStack;
+			if (OutAddedCount)
+			{
+				*OutAddedCount += ToStack;
+			}
 		}
 
 		if (Remaining <= 0)
@@ -758,36 +745,42 @@ bool UDaInventoryComponent::Internal_AddItem(FPrimaryAssetId ItemDefinitionID, i
 		}
 	}
 
-	// Create new entries for remaining items (may need multiple slots for large stack counts)
-	while (Remaining > 0)
-	{
-		// Find an empty slot
-		int32 TargetSlot = INDEX_NONE;
+	// Create new entries for remaining items (may need multiple slots for large stack counts).
+	// Every slot this add needs is found up front in one pass over the occupancy bitmap.
+	const int32 EntryStackSize = FMath::Max(1, Def->MaxStackCount);
+	const int32 EntriesNeeded = FMath::DivideAndRoundUp(Remaining, EntryStackSize);
 
-		// Prefer SlotHint if valid and empty (only for first new entry)
-		if (SlotHint >= 0 && SlotHint < MaxSlots)
-		{
-			if (InventoryList.FindBySlot(SlotHint) == nullptr)
-			{
-				TargetSlot = SlotHint;
-			}
-			SlotHint = INDEX_NONE; // Only use hint once
-		}
+	// Never more than the free slots, however large the request
+	TArray<int32> TargetSlots;
+	TargetSlots.Reserve(FMath::Clamp(MaxSlots - InventoryList.GetCount(), 0, EntriesNeeded));
+	InventoryList.ReserveSlots(EntriesNeeded, MaxSlots, TargetSlots);
 
-		// Otherwise find first empty slot
-		if (TargetSlot == INDEX_NONE)
+	// Prefer SlotHint if valid and empty (only for the first new entry). It displaces the last
+	// reserved slot unless it was reserved anyway.
+	if (SlotHint >= 0 && SlotHint < MaxSlots && InventoryList.IsSlotEmpty(SlotHint))
+	{
+		if (TargetSlots.Remove(SlotHint) == 0 && TargetSlots.Num() >= EntriesNeeded)
 		{
-			TargetSlot = InventoryList.FindFirstEmptySlot(MaxSlots);
+			TargetSlots.Pop();
 		}
+		TargetSlots.Insert(SlotHint, 0);
+	}
 
-		if (TargetSlot == INDEX_NONE)
+	for (int32 TargetSlot : TargetSlots)
+	{
+		// The added-broadcast below reaches arbitrary listeners, and one of them may already have
+		// filled a slot we reserved.
+		if (!InventoryList.IsSlotEmpty(TargetSlot))
 		{
-			LOG_WARNING("Internal_AddItem: inventory full, %d items could not be added (MaxSlots=%d)", Remaining, MaxSlots);
-			return Remaining < StackCount; // Partial success if we added some
+			TargetSlot = InventoryList.FindFirstEmptySlot(MaxSlots);
+			if (TargetSlot == INDEX_NONE)
+			{
+				break;
+			}
 		}
 
 		// Create new entry, clamped to max stack size
-		const int32 EntryCount = FMath::Min(Remaining, Def->MaxStackCount);
+		const int32 EntryCount = FMath::Min(Remaining, EntryStackSize);
 
 		FDaInventoryEntry NewEntry;
 		NewEntry.ItemID = FGuid::NewGuid();
@@ -813,11 +806,303 @@ bool UDaInventoryComponent::Internal_AddItem(FPrimaryAssetId ItemDefinitionID, i
 
 		InventoryList.AddEntry(NewEntry);
 		Remaining -= EntryCount;
+		if (OutAddedCount)
+		{
+			*OutAddedCount += EntryCount;
+		}
+	}
+
+	if (Remaining > 0)
+	{
+		LOG_WARNING("Internal_AddItem: inventory full, %d items could not be added (MaxSlots=%d)", Remaining, MaxSlots);
+		return Remaining < StackCount; // Partial success if we added some
 	}
 
 	return true;
 }
 
+bool UDaInventoryComponent::Internal_RemoveItem(int32 SlotIndex, int32 Count)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	if (Count < 0)
+	{
+		LOG_WARNING("Internal_RemoveItem: invalid Count %d", Count);
+		return false;
+	}
+
+	const FDaInventoryEntry* Entry = InventoryList.FindBySlot(SlotIndex);
+	if (!Entry)
+	{
+		LOG_WARNING("Internal_RemoveItem: no entry at slot %d", SlotIndex);
+		return false;
+	}
+
+	if (Count == 0 || Count >= Entry->StackCount)
+	{
+		InventoryList.RemoveEntry(SlotIndex);
+	}
+	else
+	{
+		FDaInventoryEntry Updated = *Entry;
+		Updated.StackCount -= Count;
+		InventoryList.UpdateEntry(SlotIndex, Updated);
+	}
+	return true;
+}
+
+bool UDaInventoryComponent::Internal_MoveItem(int32 FromSlot, int32 ToSlot)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	if (FromSlot < 0 || FromSlot >= MaxSlots || ToSlot < 0 || ToSlot >= MaxSlots || FromSlot == ToSlot)
+	{
+		LOG_WARNING("Internal_MoveItem: invalid slot range From=%d To=%d (MaxSlots=%d)", FromSlot, ToSlot, MaxSlots);
+		return false;
+	}
+
+	const FDaInventoryEntry* FromEntry = InventoryList.FindBySlot(FromSlot);
+	if (!FromEntry)
+	{
+		LOG_WARNING("Internal_MoveItem: no entry at from-slot %d", FromSlot);
+		return false;
+	}
+
+	const FDaInventoryEntry* ToEntry = InventoryList.FindBySlot(ToSlot);
+	if (ToEntry)
+	{
+		// Swap: update both entries with swapped slot indices
+		FDaInventoryEntry UpdatedFrom = *FromEntry;
+		FDaInventoryEntry UpdatedTo = *ToEntry;
+		UpdatedFrom.SlotIndex = ToSlot;
+		UpdatedTo.SlotIndex = FromSlot;
+		InventoryList.UpdateEntry(FromSlot, UpdatedTo);
+		InventoryList.UpdateEntry(ToSlot, UpdatedFrom);
+	}
+	else
+	{
+		// Move: update slot index in-place to preserve FastArray identity (change delta, not remove/add)
+		FDaInventoryEntry Updated = *FromEntry;
+		Updated.SlotIndex = ToSlot;
+		InventoryList.UpdateEntry(FromSlot, Updated);
+	}
+	return true;
+}
+
+bool UDaInventoryComponent::Internal_SplitItem(int32 FromSlot, int32 ToSlot, int32 Count)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	const FDaInventoryEntry* Source = InventoryList.FindBySlot(FromSlot);
+	if (!Source)
+	{
+		LOG_WARNING("Internal_SplitItem: no entry at slot %d", FromSlot);
+		return false;
+	}
+
+	// A split has to leave something behind; moving the whole stack is a Move.
+	if (Count <= 0 || Count >= Source->StackCount)
+	{
+		LOG_WARNING("Internal_SplitItem: invalid Count %d for a stack of %d at slot %d", Count, Source->StackCount, FromSlot);
+		return false;
+	}
+
+	if (ToSlot < 0)
+	{
+		ToSlot = InventoryList.FindFirstEmptySlot(MaxSlots);
+	}
+	if (ToSlot < 0 || ToSlot >= MaxSlots || !InventoryList.IsSlotEmpty(ToSlot))
+	{
+		LOG_WARNING("Internal_SplitItem: target slot %d is out of range or occupied (MaxSlots=%d)", ToSlot, MaxSlots);
+		return false;
+	}
+
+	// Same rule as a partial drop: the original entry keeps its ItemID, the split-off part is a
+	// new instance.
+	FDaInventoryEntry NewEntry = *Source;
+	NewEntry.ItemID = FGuid::NewGuid();
+	NewEntry.SlotIndex = ToSlot;
+	NewEntry.StackCount = Count;
+
+	FDaInventoryEntry Updated = *Source;
+	Updated.StackCount -= Count;
+	Source = nullptr;
+
+	InventoryList.UpdateEntry(FromSlot, Updated);
+	InventoryList.AddEntry(NewEntry);
+	return true;
+}
+
+// ---------------------------------------------------------------------------
+// Internal batch logic (server-only)
+// ---------------------------------------------------------------------------
+
+bool UDaInventoryComponent::Internal_ApplyInventoryBatch(const TArray<FDaInventoryOp>& Ops)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return false;
+	}
+
+	// The op list is untrusted input, and a rollback copies the whole inventory.
+	if (Ops.Num() == 0 || Ops.Num() > MaxBatchOps || bApplyingInventoryBatch)
+	{
+		LOG_WARNING("Internal_ApplyInventoryBatch: rejected batch of %d op(s) (max %d%s)",
+			Ops.Num(), MaxBatchOps, bApplyingInventoryBatch ? ", already inside a batch" : "");
+		Client_NotifyInventoryBatchApplied(false);
+		return false;
+	}
+
+	// Everything a rollback needs. The loadout only changes through removals, which are held
+	// back with the rest of the broadcasts below, so the entries are the whole state.
+	const TArray<FDaInventoryEntry> Snapshot = InventoryList.GetEntries();
+
+	struct FPendingUse
+	{
+		FDaInventoryEntry Entry;
+		UDaItemDefinition* Def;
+	};
+	TArray<FPendingUse> PendingUses;
+
+	bApplyingInventoryBatch = true;
+
+	bool bSucceeded = true;
+	for (int32 OpIndex = 0; OpIndex < Ops.Num() && bSucceeded; ++OpIndex)
+	{
+		const FDaInventoryOp& Op = Ops[OpIndex];
+		switch (Op.Type)
+		{
+		case EDaInventoryOpType::Add:
+		{
+			// All or nothing: a partial add is a success for AddItem, but not for a transaction.
+			int32 Added = 0;
+			bSucceeded = Internal_AddItem(Op.ItemDefinitionID, Op.Count, Op.SlotIndex, &Added) && Added == Op.Count;
+			break;
+		}
+		case EDaInventoryOpType::Remove:
+			bSucceeded = Internal_RemoveItem(Op.SlotIndex, Op.Count);
+			break;
+		case EDaInventoryOpType::Move:
+			bSucceeded = Internal_MoveItem(Op.SlotIndex, Op.ToSlot);
+			break;
+		case EDaInventoryOpType::Split:
+			bSucceeded = Internal_SplitItem(Op.SlotIndex, Op.ToSlot, Op.Count);
+			break;
+		case EDaInventoryOpType::Use:
+		{
+			// Validated and consumed now; the gameplay event waits for the commit (see the header).
+			const FDaInventoryEntry* Entry = InventoryList.FindBySlot(Op.SlotIndex);
+			if (!Entry)
+			{
+				LOG_WARNING("Internal_ApplyInventoryBatch: no entry to use at slot %d", Op.SlotIndex);
+				bSucceeded = false;
+				break;
+			}
+			const FDaInventoryEntry UsedEntry = *Entry;
+			Entry = nullptr;
+
+			UDaItemDefinition* Def = ResolveItemDefinition(UsedEntry.ItemDefinitionID);
+			if (!Def)
+			{
+				LOG_WARNING("Internal_ApplyInventoryBatch: failed to load item definition %s", *UsedEntry.ItemDefinitionID.ToString());
+				bSucceeded = false;
+				break;
+			}
+			PendingUses.Add({ UsedEntry, Def });
+			bSucceeded = !Def->bConsumeOnUse || Internal_RemoveItem(Op.SlotIndex, 1);
+			break;
+		}
+		case EDaInventoryOpType::SetStat:
+			bSucceeded = IsClientWritableStat(Op.StatTag) && Internal_SetItemStat(Op.ItemID, Op.StatTag, Op.Count);
+			break;
+		default:
+			bSucceeded = false;
+			break;
+		}
+
+		if (!bSucceeded)
+		{
+			LOG_WARNING("Internal_ApplyInventoryBatch: op %d of %d (type %d) failed — rolling back",
+				OpIndex, Ops.Num(), static_cast<int32>(Op.Type));
+		}
+	}
+
+	bApplyingInventoryBatch = false;
+
+	if (!bSucceeded)
+	{
+		// Nothing was broadcast, so putting the entries back is all a rollback takes.
+		InventoryList.RestoreEntries(Snapshot);
+		Client_NotifyInventoryBatchApplied(false);
+		return false;
+	}
+
+	// Coalesce: one broadcast per entry that ended up different, however many ops touched it.
+	// Compared by contents: both arrays are copies, and copying an entry resets its replication key.
+	// Copied first: the broadcasts can re-enter and mutate Entries.
+	const TArray<FDaInventoryEntry> Final = InventoryList.GetEntries();
+	TMap<FGuid, const FDaInventoryEntry*> Before;
+	Before.Reserve(Snapshot.Num());
+	for (const FDaInventoryEntry& Entry : Snapshot)
+	{
+		Before.Add(Entry.ItemID, &Entry);
+	}
+
+	TSet<FGuid> Remaining;
+	Remaining.Reserve(Final.Num());
+	for (const FDaInventoryEntry& Entry : Final)
+	{
+		Remaining.Add(Entry.ItemID);
+	}
+	for (const FDaInventoryEntry& Entry : Snapshot)
+	{
+		if (!Remaining.Contains(Entry.ItemID))
+		{
+			OnEntryRemovedInternal(Entry);
+		}
+	}
+	for (const FDaInventoryEntry& Entry : Final)
+	{
+		const FDaInventoryEntry* const* Old = Before.Find(Entry.ItemID);
+		if (!Old)
+		{
+			OnEntryAddedInternal(Entry);
+		}
+		else if (!(*Old)->HasSameContents(Entry))
+		{
+			OnEntryChangedInternal(Entry);
+		}
+	}
+
+	// Committed: now the uses may reach the ability system.
+	AActor* Avatar = ResolveOwnerAvatar();
+	for (const FPendingUse& Use : PendingUses)
+	{
+		if (Avatar)
+		{
+			FGameplayEventData Payload;
+			Payload.EventTag = CoreGameplayTags::TAG_Action_UseItem;
+			Payload.Instigator = Avatar;
+			Payload.OptionalObject = Use.Def;
+			Payload.EventMagnitude = Use.Entry.SlotIndex;
+			UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Avatar, CoreGameplayTags::TAG_Action_UseItem, Payload);
+		}
+		Client_NotifyItemUsed(Use.Entry);
+	}
+
+	Client_NotifyInventoryBatchApplied(true);
+	return true;
+}
+
 // ---------------------------------------------------------------------------
 // Internal use/drop logic (server-only)
 // ---------------------------------------------------------------------------
@@ -891,11 +1176,13 @@ bool UDaInventoryComponent::Internal_DropItem(int32 SlotIndex, int32 Count)
 		LOG_WARNING("Internal_DropItem: no entry at slot %d", SlotIndex);
 		return false;
 	}
+	const FDaInventoryEntry DroppedEntry = *Entry;
+	Entry = nullptr;
 
-	UDaItemDefinition* Def = ResolveItemDefinition(Entry->ItemDefinitionID);
+	UDaItemDefinition* Def = ResolveItemDefinition(DroppedEntry.ItemDefinitionID);
 	if (!Def)
 	{
-		LOG_WARNING("Internal_DropItem: failed to load item definition %s", *Entry->ItemDefinitionID.ToString());
+		LOG_WARNING("Internal_DropItem: failed to load item definition %s", *DroppedEntry.ItemDefinitionID.ToString());
 		return false;
 	}
 
@@ -906,56 +1193,40 @@ bool UDaInventoryComponent::Internal_DropItem(int32 SlotIndex, int32 Count)
 		return false;
 	}
 
-	const int32 DropCount = (Count == 0) ? Entry->StackCount : FMath::Min(Count, Entry->StackCount);
-	const FDaInventoryEntry DroppedEntry = *Entry;
-	const FGuid DroppedItemID = Entry->ItemID;
-	Entry = nullptr;
-
-	// Resolve pickup class before mutating inventory so a bad class fails the whole drop
-	UClass* PickupClass = Def->PickupActorClass.IsNull() ? ADaItemActor::StaticClass() : Def->PickupActorClass.LoadSynchronous();
-	if (!PickupClass)
+	UDaItemDropSubsystem* DropSubsystem = UDaItemDropSubsystem::Get(this);
+	if (!DropSubsystem)
 	{
-		LOG_WARNING("Internal_DropItem: failed to load PickupActorClass for %s", *DroppedEntry.ItemDefinitionID.ToString());
+		LOG_WARNING("Internal_DropItem: no UDaItemDropSubsystem in world %s", *GetNameSafe(GetWorld()));
 		return false;
 	}
 
-	// The synchronous loads above can tick the loading path and run arbitrary code, so re-locate
-	// by identity: SlotIndex is only a name for where the item used to be.
-	const FDaInventoryEntry* Current = FindEntryByItemID(DroppedItemID);
+	// A cold definition load can run arbitrary code, so re-locate by identity: SlotIndex is only
+	// a name for where the item used to be.
+	const FDaInventoryEntry* Current = FindEntryByItemID(DroppedEntry.ItemID);
 	if (!Current)
 	{
-		LOG_WARNING("Internal_DropItem: item %s left the inventory before it could be dropped", *DroppedItemID.ToString());
+		LOG_WARNING("Internal_DropItem: item %s left the inventory before it could be dropped", *DroppedEntry.ItemID.ToString());
 		return false;
 	}
 
-	if (!RemoveItem(Current->SlotIndex, DropCount >= DroppedEntry.StackCount ? 0 : DropCount))
+	const int32 DropCount = (Count == 0) ? Current->StackCount : FMath::Min(Count, Current->StackCount);
+	const bool bWholeInstance = DropCount >= Current->StackCount;
+	FDaInventoryEntry NotifyEntry = *Current;
+	Current = nullptr;
+
+	// The entry leaves now; the pickup follows once its class and mesh are streamed in (usually
+	// at once — both are held resident while the item sits in an inventory). Nothing here loads
+	// synchronously, so a cold rare mesh no longer stalls the server tick.
+	if (!RemoveItem(NotifyEntry.SlotIndex, bWholeInstance ? 0 : DropCount))
 	{
 		return false;
 	}
 
-	// Spawn the world pickup in front of the avatar
+	// Spawn the world pickup in front of the avatar, where it was when the drop was accepted
 	const FVector SpawnLocation = Avatar->GetActorLocation() + Avatar->GetActorForwardVector() * 150.f;
 	const FTransform SpawnTransform(Avatar->GetActorRotation(), SpawnLocation);
+	DropSubsystem->QueueDrop(NotifyEntry, bWholeInstance, SpawnTransform, Def->PickupActorClass, Def->DisplayMesh);
 
-	// A single pickup actor represents the whole dropped stack
-	if (ADaItemActor* Pickup = GetWorld()->SpawnActorDeferred<ADaItemActor>(PickupClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn))
-	{
-		if (DropCount >= DroppedEntry.StackCount)
-		{
-			// The instance left the inventory whole, so hand the actor its entry: picking it back
-			// up restores this same item, per-instance stats and all.
-			Pickup->InitializeDroppedItem(DroppedEntry, Def->DisplayMesh.LoadSynchronous());
-		}
-		else
-		{
-			// A partial stack leaves the original entry (and its ItemID) behind in the inventory,
-			// so what hits the ground is a new instance and gets a fresh ID on pickup.
-			Pickup->InitializeDroppedItem(DroppedEntry.ItemDefinitionID, Def->DisplayMesh.LoadSynchronous());
-		}
-		Pickup->FinishSpawning(SpawnTransform);
-	}
-
-	FDaInventoryEntry NotifyEntry = DroppedEntry;
 	NotifyEntry.StackCount = DropCount;
 	Client_NotifyItemDropped(NotifyEntry);
 	return true;
@@ -990,39 +1261,38 @@ bool UDaInventoryComponent::Internal_SetItemStat(const FGuid& ItemID, FGameplayT
 	// Counts are magnitudes; a negative one has no meaning and 0 is the "remove" encoding.
 	Count = FMath::Max(0, Count);
 
-	for (FDaInventoryEntry& Entry : InventoryList.Entries)
+	FDaInventoryEntry* Found = InventoryList.FindByItemIDMutable(ItemID);
+	if (!Found)
 	{
-		if (Entry.ItemID == ItemID)
-		{
-			if (Entry.MaxStackCount > 1)
-			{
-				LOG_WARNING("Internal_SetItemStat on stackable item %s (MaxStackCount=%d) — per-instance stats require MaxStackCount=1",
-					*Entry.ItemDefinitionID.ToString(), Entry.MaxStackCount);
-			}
-
-			// Cap the array a client can grow. Existing tags (and removals) always go through.
-			if (Count > 0 && Entry.GetStatCount(StatTag) == 0 && Entry.StatTags.Num() >= MaxStatTagsPerEntry)
-			{
-				LOG_WARNING("Internal_SetItemStat: item %s already holds %d stat tags (max %d) — rejected %s",
-					*ItemID.ToString(), Entry.StatTags.Num(), MaxStatTagsPerEntry, *StatTag.ToString());
-				return false;
-			}
+		LOG_WARNING("Internal_SetItemStat: item %s not in inventory", *ItemID.ToString());
+		return false;
+	}
 
-			Entry.SetStatCount(StatTag, Count);
-			InventoryList.MarkItemDirty(Entry);
+	FDaInventoryEntry& Entry = *Found;
+	if (Entry.MaxStackCount > 1)
+	{
+		LOG_WARNING("Internal_SetItemStat on stackable item %s (MaxStackCount=%d) — per-instance stats require MaxStackCount=1",
+			*Entry.ItemDefinitionID.ToString(), Entry.MaxStackCount);
+	}
 
-			// Snapshot, then broadcast — the discipline the other five guards in this file follow.
-			// `Entry` is a reference into InventoryList.Entries, and the listeners this reaches
-			// (equipment penalties, wear visuals) are free to add or remove entries underneath it.
-			const FDaInventoryEntry Changed = Entry;
-			// Mirrors FDaInventoryList::UpdateEntry's authority broadcast discipline.
-			OnEntryChangedInternal(Changed);
-			return true;
-		}
+	// Cap the array a client can grow. Existing tags (and removals) always go through.
+	if (Count > 0 && Entry.GetStatCount(StatTag) == 0 && Entry.StatTags.Num() >= MaxStatTagsPerEntry)
+	{
+		LOG_WARNING("Internal_SetItemStat: item %s already holds %d stat tags (max %d) — rejected %s",
+			*ItemID.ToString(), Entry.StatTags.Num(), MaxStatTagsPerEntry, *StatTag.ToString());
+		return false;
 	}
 
-	LOG_WARNING("Internal_SetItemStat: item %s not in inventory", *ItemID.ToString());
-	return false;
+	Entry.SetStatCount(StatTag, Count);
+	InventoryList.MarkItemDirty(Entry);
+
+	// Snapshot, then broadcast — the discipline the other five guards in this file follow.
+	// `Entry` is a reference into InventoryList.Entries, and the listeners this reaches
+	// (equipment penalties, wear visuals) are free to add or remove entries underneath it.
+	const FDaInventoryEntry Changed = Entry;
+	// Mirrors FDaInventoryList::UpdateEntry's authority broadcast discipline.
+	OnEntryChangedInternal(Changed);
+	return true;
 }
 
 void UDaInventoryComponent::InitializeConditionStats(FDaInventoryEntry& Entry, const UDaItemDefinition& Def)
@@ -1282,23 +1552,9 @@ void UDaInventoryComponent::OnRep_Loadout()
 
 UDaItemDefinition* UDaInventoryComponent::ResolveItemDefinition(FPrimaryAssetId ItemDefinitionID) const
 {
-	if (!ItemDefinitionID.IsValid())
-	{
-		return nullptr;
-	}
-
-	// Fast path: already loaded via the AssetManager
-	UDaItemDefinition* Def = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(ItemDefinitionID));
-	if (!Def)
-	{
-		// Synchronous load via resolved asset path (definitions are small data assets)
-		FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(ItemDefinitionID);
-		if (AssetPath.IsValid())
-		{
-			Def = Cast<UDaItemDefinition>(AssetPath.TryLoad());
-		}
-	}
-	return Def;
+	// Held items are kept resident by the cache (see OnEntryAddedInternal), so this is a lookup on
+	// every path but the first sighting of an item nobody preloaded.
+	return UDaItemDefinitionCache::ResolveDefinitionBlocking(this, ItemDefinitionID);
 }
 
 const UDaItemDefinition* UDaInventoryComponent::ResolveConditionDefinition(const FGuid& ItemID) const
@@ -1347,11 +1603,27 @@ AActor* UDaInventoryComponent::ResolveOwnerAvatar() const
 
 void UDaInventoryComponent::OnEntryAddedInternal(const FDaInventoryEntry& Entry)
 {
+	if (bApplyingInventoryBatch)
+	{
+		return; // Internal_ApplyInventoryBatch broadcasts the net result at commit
+	}
+
+	// Keep the definition and its icon/mesh/pickup/ability-set resident while we hold the item.
+	if (UDaItemDefinitionCache* Cache = UDaItemDefinitionCache::Get(this))
+	{
+		Cache->AddHeldReference(Entry.ItemDefinitionID);
+	}
+
 	OnEntryAdded.Broadcast(Entry, Entry.SlotIndex);
 }
 
 void UDaInventoryComponent::OnEntryRemovedInternal(const FDaInventoryEntry& Entry)
 {
+	if (bApplyingInventoryBatch)
+	{
+		return; // including the loadout cleanup below: a rolled-back removal must not clear it
+	}
+
 	// Every full-removal path (RemoveItem, use-consume, drop, load-wipe) lands here, so this is
 	// the one place that has to keep the loadout from naming an item the inventory no longer
 	// holds. Done BEFORE the broadcast so listeners — the equipment manager above all — see a
@@ -1361,10 +1633,29 @@ void UDaInventoryComponent::OnEntryRemovedInternal(const FDaInventoryEntry& Entr
 		ClearLoadoutForItem(Entry.ItemID);
 	}
 
+	if (UDaItemDefinitionCache* Cache = UDaItemDefinitionCache::Get(this))
+	{
+		Cache->RemoveHeldReference(Entry.ItemDefinitionID);
+	}
+
+	ItemViewModels.Remove(Entry.ItemID);
+
 	OnEntryRemoved.Broadcast(Entry, Entry.SlotIndex);
 }
 
 void UDaInventoryComponent::OnEntryChangedInternal(const FDaInventoryEntry& Entry)
 {
+	if (bApplyingInventoryBatch)
+	{
+		return;
+	}
+
+	// Refreshed before the broadcast so listeners reading the pooled view-model see the new values.
+	if (UDaInventoryItemBase* Item = FindItemViewModel(Entry.ItemID))
+	{
+		Item->RefreshFromEntry(Entry);
+		Item->OnInventoryItemUpdated.Broadcast(Item);
+	}
+
 	OnEntryChanged.Broadcast(Entry, Entry.SlotIndex);
 }
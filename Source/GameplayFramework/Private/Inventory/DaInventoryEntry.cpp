@@ -63,6 +63,10 @@ void FDaInventoryEntry::RebuildStatCountMap()
 
 void FDaInventoryEntry::PreReplicatedRemove(const FDaInventoryList& OwnerList)
 {
+	// The entry is still in the array while listeners run; the list's PostReplicatedReceive marks
+	// the indexes stale again once it is really gone.
+	OwnerList.MarkIndexesStale();
+
 	if (OwnerList.OwnerComponent)
 	{
 		OwnerList.OwnerComponent->OnEntryRemovedInternal(*this);
@@ -71,8 +75,10 @@ void FDaInventoryEntry::PreReplicatedRemove(const FDaInventoryList& OwnerList)
 
 void FDaInventoryEntry::PostReplicatedAdd(const FDaInventoryList& OwnerList)
 {
-	// Before the broadcast: listeners read stats through the accelerator.
+	// Before the broadcast: listeners read stats through the accelerator, and look entries up
+	// through the list's indexes.
 	RebuildStatCountMap();
+	OwnerList.MarkIndexesStale();
 
 	if (OwnerList.OwnerComponent)
 	{
@@ -83,6 +89,8 @@ void FDaInventoryEntry::PostReplicatedAdd(const FDaInventoryList& OwnerList)
 void FDaInventoryEntry::PostReplicatedChange(const FDaInventoryList& OwnerList)
 {
 	RebuildStatCountMap();
+	// A move replicates as a change of SlotIndex.
+	OwnerList.MarkIndexesStale();
 
 	if (OwnerList.OwnerComponent)
 	{
@@ -4,10 +4,10 @@
 #include "Inventory/DaInventoryItemBase.h"
 
 #include "CoreGameplayTags.h"
-#include "Engine/AssetManager.h"
 #include "Equipment/DaEquipmentManagerComponent.h"
 #include "Inventory/DaInventoryEntry.h"
 #include "Inventory/DaItemDefinition.h"
+#include "Inventory/DaItemDefinitionCache.h"
 
 UDaInventoryItemBase::UDaInventoryItemBase()
 {
@@ -17,21 +17,43 @@ UDaInventoryItemBase* UDaInventoryItemBase::CreateFromEntry(const FDaInventoryEn
 {
 	UObject* OuterToUse = Outer ? Outer : (UObject*)GetTransientPackage();
 	UDaInventoryItemBase* NewItem = NewObject<UDaInventoryItemBase>(OuterToUse);
+	NewItem->RefreshFromEntry(Entry);
+	return NewItem;
+}
 
-	// Resolve the item definition from its primary asset id (loaded copy if present,
-	// otherwise synchronously load the asset path) — mirrors UDaInventoryComponent.
-	UDaItemDefinition* Def = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(Entry.ItemDefinitionID));
-	if (!Def)
+void UDaInventoryItemBase::RefreshFromEntry(const FDaInventoryEntry& Entry)
+{
+	SourceEntry = Entry;
+
+	// A view-model must never hitch the UI: when the definition is not resident yet, show the
+	// entry's own data now and fill in the definition's display data once the cache streams it in.
+	UDaItemDefinitionCache* Cache = UDaItemDefinitionCache::Get(GetOuter());
+	if (!Cache)
 	{
-		const FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(Entry.ItemDefinitionID);
-		if (AssetPath.IsValid())
-		{
-			Def = Cast<UDaItemDefinition>(AssetPath.TryLoad());
-		}
+		// No game instance (editor preview, transient outer): nothing to stream through.
+		PopulateFromEntry(Entry, UDaItemDefinitionCache::ResolveDefinitionBlocking(GetOuter(), Entry.ItemDefinitionID));
+		return;
 	}
 
-	NewItem->PopulateFromEntry(Entry, Def);
-	return NewItem;
+	UDaItemDefinition* Def = Cache->FindDefinition(Entry.ItemDefinitionID);
+	PopulateFromEntry(Entry, Def);
+	if (!Def && Entry.ItemDefinitionID.IsValid())
+	{
+		// Re-populates from SourceEntry, not the entry captured here: a pooled view-model may have
+		// been refreshed (stack count, stats) while the definition was streaming.
+		TWeakObjectPtr<UDaInventoryItemBase> WeakItem = this;
+		const FGuid RequestedItemID = Entry.ItemID;
+		Cache->RequestDefinition(Entry.ItemDefinitionID, FDaItemDefinitionLoaded::CreateLambda(
+			[WeakItem, RequestedItemID](UDaItemDefinition* LoadedDef)
+			{
+				UDaInventoryItemBase* Item = WeakItem.Get();
+				if (Item && LoadedDef && Item->ItemID == RequestedItemID)
+				{
+					Item->PopulateFromEntry(Item->SourceEntry, LoadedDef);
+					Item->OnInventoryItemUpdated.Broadcast(Item);
+				}
+			}));
+	}
 }
 
 UDaInventoryItemBase* UDaInventoryItemBase::CreateFromData(const FDaInventoryItemData& Data)
@@ -151,6 +173,7 @@ void UDaInventoryItemBase::ClearData()
 	Description = FName();
 	ItemID = FGuid();
 	ItemDefinitionID = FPrimaryAssetId();
+	SourceEntry = FDaInventoryEntry();
 	SlotIndex = INDEX_NONE;
 	StackCount = 1;
 	StatCounts.Reset();
@@ -2,8 +2,13 @@
 
 #include "Inventory/DaInventoryList.h"
 
+#include "GameplayFramework.h"
 #include "Inventory/DaInventoryComponent.h"
 
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<bool> CVarValidateInventoryIndexes(TEXT("da.InventoryValidateIndexes"), false, TEXT("Validate inventory slot/ItemID lookup indexes against a full scan after every mutation"), ECVF_Cheat);
+#endif
+
 namespace
 {
 	// Mutators only run on the authority; FastArray callbacks only run on
@@ -14,6 +19,16 @@ namespace
 	{
 		return OwnerComponent && OwnerComponent->GetOwnerRole() == ROLE_Authority;
 	}
+
+	void ValidateIndexesIfRequested(const FDaInventoryList& List)
+	{
+#if !UE_BUILD_SHIPPING
+		if (CVarValidateInventoryIndexes.GetValueOnGameThread())
+		{
+			List.ValidateIndexes();
+		}
+#endif
+	}
 }
 
 void FDaInventoryList::AddEntry(const FDaInventoryEntry& NewEntry)
@@ -25,6 +40,8 @@ void FDaInventoryList::AddEntry(const FDaInventoryEntry& NewEntry)
 	// in-place, harmless either way.
 	Entries.Last().RebuildStatCountMap();
 	MarkItemDirty(Entries.Last());
+	IndexEntry(Entries.Num() - 1);
+	ValidateIndexesIfRequested(*this);
 
 	if (ShouldBroadcastLocally(OwnerComponent))
 	{
@@ -34,29 +51,42 @@ void FDaInventoryList::AddEntry(const FDaInventoryEntry& NewEntry)
 
 void FDaInventoryList::RemoveEntry(int32 SlotIndex)
 {
-	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	const int32 Index = IndexOfSlot(SlotIndex);
+	if (Index == INDEX_NONE)
 	{
-		if (Entries[i].SlotIndex == SlotIndex)
-		{
-			const FDaInventoryEntry RemovedEntry = Entries[i];
-			Entries.RemoveAt(i);
-			MarkArrayDirty();
+		return;
+	}
 
-			if (ShouldBroadcastLocally(OwnerComponent))
-			{
-				OwnerComponent->OnEntryRemovedInternal(RemovedEntry);
-			}
-			return;
-		}
+	const FDaInventoryEntry RemovedEntry = Entries[Index];
+	UnindexEntry(Index);
+	Entries.RemoveAt(Index);
+	MarkArrayDirty();
+
+	// RemoveAt keeps the order listeners see, so everything after the hole moved down one.
+	for (int32 i = Index; i < Entries.Num(); ++i)
+	{
+		IndexEntry(i);
+	}
+	ValidateIndexesIfRequested(*this);
+
+	if (ShouldBroadcastLocally(OwnerComponent))
+	{
+		OwnerComponent->OnEntryRemovedInternal(RemovedEntry);
 	}
 }
 
 void FDaInventoryList::UpdateEntry(int32 SlotIndex, const FDaInventoryEntry& Updated)
 {
-	if (FDaInventoryEntry* Entry = FindBySlotMutable(SlotIndex))
+	const int32 Index = IndexOfSlot(SlotIndex);
+	if (Index != INDEX_NONE)
 	{
+		FDaInventoryEntry* Entry = &Entries[Index];
+		// Updated may carry a different slot (moves) or a different ItemID (swaps), so re-key.
+		UnindexEntry(Index);
 		*Entry = Updated;
+		IndexEntry(Index);
 		MarkItemDirty(*Entry);
+		ValidateIndexesIfRequested(*this);
 
 		if (ShouldBroadcastLocally(OwnerComponent))
 		{
@@ -65,25 +95,99 @@ void FDaInventoryList::UpdateEntry(int32 SlotIndex, const FDaInventoryEntry& Upd
 	}
 }
 
-int32 FDaInventoryList::FindFirstEmptySlot(int32 MaxSize) const
+void FDaInventoryList::EmptyEntries()
 {
-	TSet<int32> OccupiedSlots;
-	OccupiedSlots.Reserve(Entries.Num());
+	Entries.Empty();
+	SlotToEntryIndex.Reset();
+	ItemIDToEntryIndex.Reset();
+	FMemory::Memzero(OccupiedSlotWords.GetData(), OccupiedSlotWords.Num() * sizeof(uint32));
+	bIndexesStale = false;
+	MarkArrayDirty();
+}
 
-	for (const FDaInventoryEntry& Entry : Entries)
+void FDaInventoryList::RestoreEntries(const TArray<FDaInventoryEntry>& Snapshot)
+{
+	// Moving the array keeps the live items' replication IDs and keys; copying an item resets them
+	TArray<FDaInventoryEntry> Live = MoveTemp(Entries);
+	TMap<FGuid, int32> LiveIndexByItemID;
+	LiveIndexByItemID.Reserve(Live.Num());
+	for (int32 Index = 0; Index < Live.Num(); Index++)
 	{
-		OccupiedSlots.Add(Entry.SlotIndex);
+		LiveIndexByItemID.Add(Live[Index].ItemID, Index);
 	}
 
-	for (int32 i = 0; i < MaxSize; ++i)
+	Entries.Reset(Snapshot.Num());
+	for (const FDaInventoryEntry& Saved : Snapshot)
 	{
-		if (!OccupiedSlots.Contains(i))
+		FDaInventoryEntry& Restored = Entries.Add_GetRef(Saved);
+		const int32* LiveIndex = LiveIndexByItemID.Find(Saved.ItemID);
+		if (LiveIndex == nullptr)
+		{
+			// Removed during the batch: comes back as a new item
+			MarkItemDirty(Restored);
+			continue;
+		}
+
+		const FDaInventoryEntry& Current = Live[*LiveIndex];
+		Restored.ReplicationID = Current.ReplicationID;
+		Restored.ReplicationKey = Current.ReplicationKey;
+		Restored.MostRecentArrayReplicationKey = Current.MostRecentArrayReplicationKey;
+		if (!Current.HasSameContents(Saved))
 		{
-			return i;
+			MarkItemDirty(Restored);
 		}
 	}
 
-	return INDEX_NONE;
+	// Entries added during the batch are gone
+	MarkArrayDirty();
+	RebuildIndexes();
+	ValidateIndexesIfRequested(*this);
+}
+
+void FDaInventoryList::SetSlotCapacity(int32 MaxSize)
+{
+	const int32 NumWords = FMath::DivideAndRoundUp(FMath::Max(0, MaxSize), 32);
+	if (NumWords > OccupiedSlotWords.Num())
+	{
+		OccupiedSlotWords.SetNumZeroed(NumWords);
+	}
+}
+
+void FDaInventoryList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	// Removed entries are swapped out of the array only after their PreReplicatedRemove ran, so
+	// positions indexed during the callbacks are already wrong by the time we get here.
+	MarkIndexesStale();
+}
+
+int32 FDaInventoryList::FindFirstEmptySlot(int32 MaxSize) const
+{
+	return FindEmptySlotFrom(0, MaxSize);
+}
+
+int32 FDaInventoryList::ReserveSlots(int32 Count, int32 MaxSize, TArray<int32>& OutSlots) const
+{
+	int32 Found = 0;
+	int32 NextSlot = 0;
+	while (Found < Count)
+	{
+		const int32 Slot = FindEmptySlotFrom(NextSlot, MaxSize);
+		if (Slot == INDEX_NONE)
+		{
+			break;
+		}
+
+		OutSlots.Add(Slot);
+		NextSlot = Slot + 1;
+		++Found;
+	}
+
+	return Found;
+}
+
+bool FDaInventoryList::IsSlotEmpty(int32 SlotIndex) const
+{
+	return IndexOfSlot(SlotIndex) == INDEX_NONE;
 }
 
 int32 FDaInventoryList::FindStackableSlot(const FDaInventoryEntry& ForEntry) const
@@ -101,26 +205,247 @@ int32 FDaInventoryList::FindStackableSlot(const FDaInventoryEntry& ForEntry) con
 
 const FDaInventoryEntry* FDaInventoryList::FindBySlot(int32 SlotIndex) const
 {
-	for (const FDaInventoryEntry& Entry : Entries)
+	const int32 Index = IndexOfSlot(SlotIndex);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+FDaInventoryEntry* FDaInventoryList::FindBySlotMutable(int32 SlotIndex)
+{
+	const int32 Index = IndexOfSlot(SlotIndex);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+const FDaInventoryEntry* FDaInventoryList::FindByItemID(const FGuid& ItemID) const
+{
+	const int32 Index = IndexOfItemID(ItemID);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+FDaInventoryEntry* FDaInventoryList::FindByItemIDMutable(const FGuid& ItemID)
+{
+	const int32 Index = IndexOfItemID(ItemID);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Lookup indexes
+// ---------------------------------------------------------------------------
+
+int32 FDaInventoryList::IndexOfSlot(int32 SlotIndex) const
+{
+	EnsureIndexes();
+
+	const int32* Found = SlotToEntryIndex.Find(SlotIndex);
+	if (Found && Entries.IsValidIndex(*Found) && Entries[*Found].SlotIndex == SlotIndex)
+	{
+		return *Found;
+	}
+
+	if (Found)
+	{
+		// The index named a position that no longer holds this slot: rebuild and ask once more.
+		RebuildIndexes();
+		Found = SlotToEntryIndex.Find(SlotIndex);
+	}
+
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FDaInventoryList::IndexOfItemID(const FGuid& ItemID) const
+{
+	EnsureIndexes();
+
+	const int32* Found = ItemIDToEntryIndex.Find(ItemID);
+	if (Found && Entries.IsValidIndex(*Found) && Entries[*Found].ItemID == ItemID)
+	{
+		return *Found;
+	}
+
+	if (Found)
 	{
-		if (Entry.SlotIndex == SlotIndex)
+		RebuildIndexes();
+		Found = ItemIDToEntryIndex.Find(ItemID);
+	}
+
+	return Found ? *Found : INDEX_NONE;
+}
+
+int32 FDaInventoryList::FindEmptySlotFrom(int32 StartSlot, int32 MaxSize) const
+{
+	EnsureIndexes();
+
+	StartSlot = FMath::Max(0, StartSlot);
+	if (StartSlot >= MaxSize)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 NumWords = OccupiedSlotWords.Num();
+	uint32 Mask = ~0u << (StartSlot % 32);
+	for (int32 WordIndex = StartSlot / 32; WordIndex < NumWords; ++WordIndex, Mask = ~0u)
+	{
+		const uint32 FreeBits = ~OccupiedSlotWords[WordIndex] & Mask;
+		if (FreeBits != 0)
 		{
-			return &Entry;
+			const int32 Slot = WordIndex * 32 + static_cast<int32>(FMath::CountTrailingZeros(FreeBits));
+			return Slot < MaxSize ? Slot : INDEX_NONE;
 		}
 	}
 
-	return nullptr;
+	// Everything past the end of the bitmap is free.
+	const int32 Slot = FMath::Max(StartSlot, NumWords * 32);
+	return Slot < MaxSize ? Slot : INDEX_NONE;
 }
 
-FDaInventoryEntry* FDaInventoryList::FindBySlotMutable(int32 SlotIndex)
+void FDaInventoryList::SetSlotOccupied(int32 SlotIndex, bool bOccupied) const
+{
+	if (SlotIndex < 0)
+	{
+		return;
+	}
+
+	const int32 WordIndex = SlotIndex / 32;
+	if (WordIndex >= OccupiedSlotWords.Num())
+	{
+		if (!bOccupied)
+		{
+			return;
+		}
+		OccupiedSlotWords.SetNumZeroed(WordIndex + 1);
+	}
+
+	const uint32 Bit = 1u << (SlotIndex % 32);
+	if (bOccupied)
+	{
+		OccupiedSlotWords[WordIndex] |= Bit;
+	}
+	else
+	{
+		OccupiedSlotWords[WordIndex] &= ~Bit;
+	}
+}
+
+void FDaInventoryList::IndexEntry(int32 Index)
+{
+	const FDaInventoryEntry& Entry = Entries[Index];
+	SlotToEntryIndex.Add(Entry.SlotIndex, Index);
+	SetSlotOccupied(Entry.SlotIndex, true);
+	if (Entry.ItemID.IsValid())
+	{
+		ItemIDToEntryIndex.Add(Entry.ItemID, Index);
+	}
+}
+
+void FDaInventoryList::UnindexEntry(int32 Index)
+{
+	const FDaInventoryEntry& Entry = Entries[Index];
+
+	const int32* SlotFound = SlotToEntryIndex.Find(Entry.SlotIndex);
+	if (SlotFound && *SlotFound == Index)
+	{
+		SlotToEntryIndex.Remove(Entry.SlotIndex);
+		SetSlotOccupied(Entry.SlotIndex, false);
+	}
+
+	const int32* IDFound = ItemIDToEntryIndex.Find(Entry.ItemID);
+	if (IDFound && *IDFound == Index)
+	{
+		ItemIDToEntryIndex.Remove(Entry.ItemID);
+	}
+}
+
+void FDaInventoryList::EnsureIndexes() const
+{
+	if (bIndexesStale)
+	{
+		RebuildIndexes();
+	}
+}
+
+void FDaInventoryList::RebuildIndexes() const
+{
+	SlotToEntryIndex.Reset();
+	ItemIDToEntryIndex.Reset();
+	SlotToEntryIndex.Reserve(Entries.Num());
+	ItemIDToEntryIndex.Reserve(Entries.Num());
+	FMemory::Memzero(OccupiedSlotWords.GetData(), OccupiedSlotWords.Num() * sizeof(uint32));
+
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		// Lowest position wins, which is what the linear scans these indexes replaced returned.
+		SlotToEntryIndex.FindOrAdd(Entries[i].SlotIndex, i);
+		SetSlotOccupied(Entries[i].SlotIndex, true);
+		if (Entries[i].ItemID.IsValid())
+		{
+			ItemIDToEntryIndex.FindOrAdd(Entries[i].ItemID, i);
+		}
+	}
+
+	bIndexesStale = false;
+}
+
+bool FDaInventoryList::ValidateIndexes() const
 {
-	for (FDaInventoryEntry& Entry : Entries)
+#if !UE_BUILD_SHIPPING
+	if (bIndexesStale)
 	{
-		if (Entry.SlotIndex == SlotIndex)
+		return true; // nothing to check: the next lookup rebuilds from Entries anyway
+	}
+
+	// Every entry's keys resolve to an entry holding the same key. Compared by key rather than by
+	// position: mid-swap, UpdateEntry legitimately leaves two entries sharing one ItemID.
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FDaInventoryEntry& Entry = Entries[i];
+
+		const int32* SlotFound = SlotToEntryIndex.Find(Entry.SlotIndex);
+		if (!ensureMsgf(SlotFound && Entries.IsValidIndex(*SlotFound) && Entries[*SlotFound].SlotIndex == Entry.SlotIndex,
+			TEXT("FDaInventoryList: slot index out of sync for slot %d (entry %d of %d)"), Entry.SlotIndex, i, Entries.Num()))
 		{
-			return &Entry;
+			return false;
+		}
+
+		const int32* IDFound = Entry.ItemID.IsValid() ? ItemIDToEntryIndex.Find(Entry.ItemID) : nullptr;
+		if (!ensureMsgf(!Entry.ItemID.IsValid() || (IDFound && Entries.IsValidIndex(*IDFound) && Entries[*IDFound].ItemID == Entry.ItemID),
+			TEXT("FDaInventoryList: ItemID index out of sync for item %s (entry %d of %d)"), *Entry.ItemID.ToString(), i, Entries.Num()))
+		{
+			return false;
+		}
+	}
+
+	// And every key names a live entry; the loop above only proves every entry has a key.
+	for (const TPair<int32, int32>& Pair : SlotToEntryIndex)
+	{
+		if (!ensureMsgf(Entries.IsValidIndex(Pair.Value) && Entries[Pair.Value].SlotIndex == Pair.Key,
+			TEXT("FDaInventoryList: dead slot key %d -> %d (%d entries)"), Pair.Key, Pair.Value, Entries.Num()))
+		{
+			return false;
+		}
+	}
+	for (const TPair<FGuid, int32>& Pair : ItemIDToEntryIndex)
+	{
+		if (!ensureMsgf(Entries.IsValidIndex(Pair.Value) && Entries[Pair.Value].ItemID == Pair.Key,
+			TEXT("FDaInventoryList: dead ItemID key %s -> %d (%d entries)"), *Pair.Key.ToString(), Pair.Value, Entries.Num()))
+		{
+			return false;
+		}
+	}
+
+	// The occupancy bitmap is exactly the set of non-negative slot keys.
+	for (int32 WordIndex = 0; WordIndex < OccupiedSlotWords.Num(); ++WordIndex)
+	{
+		for (int32 Bit = 0; Bit < 32; ++Bit)
+		{
+			const int32 Slot = WordIndex * 32 + Bit;
+			const bool bOccupied = (OccupiedSlotWords[WordIndex] & (1u << Bit)) != 0;
+			if (!ensureMsgf(bOccupied == SlotToEntryIndex.Contains(Slot),
+				TEXT("FDaInventoryList: occupancy bit for slot %d is %d but the slot index says otherwise"), Slot, bOccupied ? 1 : 0))
+			{
+				return false;
+			}
 		}
 	}
 
-	return nullptr;
+#endif // !UE_BUILD_SHIPPING
+	return true;
 }
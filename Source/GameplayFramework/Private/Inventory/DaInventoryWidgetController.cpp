@@ -121,6 +121,7 @@ bool UDaInventoryWidgetController::ClearHotbarSlot(int32 SlotIndex)
 void UDaInventoryWidgetController::RebuildItems()
 {
 	Items.Reset();
+	ItemIndexByID.Reset();
 	if (!InventoryComponent)
 	{
 		return;
@@ -128,33 +129,83 @@ void UDaInventoryWidgetController::RebuildItems()
 
 	for (const FDaInventoryEntry& Entry : InventoryComponent->GetAllEntries())
 	{
-		if (UDaInventoryItemBase* Item = UDaInventoryItemBase::CreateFromEntry(Entry, this))
+		if (UDaInventoryItemBase* Item = InventoryComponent->FindOrCreateItemViewModel(Entry))
 		{
-			Items.Add(Item);
+			ItemIndexByID.Add(Entry.ItemID, Items.Add(Item));
 		}
 	}
 }
 
+void UDaInventoryWidgetController::BroadcastDiff(const FDaInventoryItemsDiff& Diff, int32 SlotIndex)
+{
+	// GetItems copies the list, so only pay for it when someone is listening.
+	if (!OnInventoryItemsDiff.IsBound() && !FOnInventoryItemChanged.IsBound() && !OnInventoryChanged.IsBound())
+	{
+		return;
+	}
+
+	const TArray<UDaInventoryItemBase*> CurrentItems = GetItems();
+	OnInventoryItemsDiff.Broadcast(CurrentItems, Diff);
+	FOnInventoryItemChanged.Broadcast(CurrentItems, SlotIndex);
+	OnInventoryChanged.Broadcast(CurrentItems);
+}
+
 void UDaInventoryWidgetController::HandleEntryAdded(const FDaInventoryEntry& Entry, int32 SlotIndex)
 {
-	// Rebuild keeps the array simple and correct; inventories are small.
-	RebuildItems();
-	FOnInventoryItemChanged.Broadcast(GetItems(), SlotIndex);
-	OnInventoryChanged.Broadcast(GetItems());
+	UDaInventoryItemBase* Item = InventoryComponent ? InventoryComponent->FindOrCreateItemViewModel(Entry) : nullptr;
+	if (!Item)
+	{
+		return;
+	}
+
+	FDaInventoryItemsDiff Diff;
+	if (const int32* Existing = ItemIndexByID.Find(Entry.ItemID))
+	{
+		// Already mirrored (bound mid-replication): treat as an update.
+		Items[*Existing] = Item;
+		Diff.Updated.Add(*Existing);
+	}
+	else
+	{
+		const int32 Index = Items.Add(Item);
+		ItemIndexByID.Add(Entry.ItemID, Index);
+		Diff.Inserted.Add(Index);
+	}
+	BroadcastDiff(Diff, SlotIndex);
 }
 
 void UDaInventoryWidgetController::HandleEntryRemoved(const FDaInventoryEntry& Entry, int32 SlotIndex)
 {
-	RebuildItems();
-	FOnInventoryItemChanged.Broadcast(GetItems(), SlotIndex);
-	OnInventoryChanged.Broadcast(GetItems());
+	int32 Index = INDEX_NONE;
+	if (!ItemIndexByID.RemoveAndCopyValue(Entry.ItemID, Index))
+	{
+		return;
+	}
+
+	Items.RemoveAt(Index);
+	for (int32 Shifted = Index; Shifted < Items.Num(); ++Shifted)
+	{
+		ItemIndexByID.Add(Items[Shifted]->ItemID, Shifted);
+	}
+
+	FDaInventoryItemsDiff Diff;
+	Diff.Removed.Add(Index);
+	BroadcastDiff(Diff, SlotIndex);
 }
 
 void UDaInventoryWidgetController::HandleEntryChanged(const FDaInventoryEntry& Entry, int32 SlotIndex)
 {
-	RebuildItems();
-	FOnInventoryItemChanged.Broadcast(GetItems(), SlotIndex);
-	OnInventoryChanged.Broadcast(GetItems());
+	// The component has already refreshed the pooled view-model in place; only the index is news.
+	const int32* Index = ItemIndexByID.Find(Entry.ItemID);
+	if (!Index)
+	{
+		HandleEntryAdded(Entry, SlotIndex);
+		return;
+	}
+
+	FDaInventoryItemsDiff Diff;
+	Diff.Updated.Add(*Index);
+	BroadcastDiff(Diff, SlotIndex);
 }
 
 void UDaInventoryWidgetController::HandleItemUsed(const FDaInventoryEntry& Entry, int32 SlotIndex)
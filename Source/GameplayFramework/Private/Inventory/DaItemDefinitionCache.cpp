@@ -0,0 +1,320 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "Inventory/DaItemDefinitionCache.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "GameplayFramework.h"
+#include "Inventory/DaItemDefinition.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ItemDefinitionCache Hits"), STAT_DaItemDefCacheHits, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ItemDefinitionCache Misses"), STAT_DaItemDefCacheMisses, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ItemDefinitionCache Blocking Loads"), STAT_DaItemDefCacheBlockingLoads, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ItemDefinitionCache Resident"), STAT_DaItemDefCacheResident, STATGROUP_DAGF);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("ItemDefinitionCache Pending"), STAT_DaItemDefCachePending, STATGROUP_DAGF);
+
+UDaItemDefinitionCache* UDaItemDefinitionCache::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	return GameInstance ? GameInstance->GetSubsystem<UDaItemDefinitionCache>() : nullptr;
+}
+
+UDaItemDefinition* UDaItemDefinitionCache::ResolveDefinitionBlocking(const UObject* WorldContextObject, const FPrimaryAssetId& Id)
+{
+	if (!Id.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (UDaItemDefinitionCache* Cache = Get(WorldContextObject))
+	{
+		return Cache->LoadDefinitionBlocking(Id);
+	}
+
+	// No game instance to hang a cache on: resolve the way the inventory always did.
+	UDaItemDefinition* Def = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(Id));
+	if (!Def)
+	{
+		const FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(Id);
+		if (AssetPath.IsValid())
+		{
+			Def = Cast<UDaItemDefinition>(AssetPath.TryLoad());
+		}
+	}
+	return Def;
+}
+
+UDaItemDefinition* UDaItemDefinitionCache::FindDefinition(const FPrimaryAssetId& Id)
+{
+	if (!Id.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (const TObjectPtr<UDaItemDefinition>* Found = Definitions.Find(Id))
+	{
+		++Stats.Hits;
+		INC_DWORD_STAT(STAT_DaItemDefCacheHits);
+		return *Found;
+	}
+
+	// Loaded by someone else (a hard reference, an earlier blocking load): adopt and pin it.
+	if (UDaItemDefinition* Loaded = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(Id)))
+	{
+		++Stats.Hits;
+		INC_DWORD_STAT(STAT_DaItemDefCacheHits);
+		StoreDefinition(Id, Loaded);
+		return Loaded;
+	}
+
+	return nullptr;
+}
+
+void UDaItemDefinitionCache::RequestDefinition(const FPrimaryAssetId& Id, FDaItemDefinitionLoaded OnLoaded)
+{
+	if (UDaItemDefinition* Def = FindDefinition(Id))
+	{
+		OnLoaded.ExecuteIfBound(Def);
+		return;
+	}
+
+	if (!Id.IsValid())
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	++Stats.Misses;
+	INC_DWORD_STAT(STAT_DaItemDefCacheMisses);
+
+	// Queued before the load starts: the AssetManager completes an already-resident load inline.
+	const bool bAlreadyPending = PendingCallbacks.Contains(Id);
+	PendingCallbacks.FindOrAdd(Id).Add(MoveTemp(OnLoaded));
+	if (bAlreadyPending)
+	{
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::Get().LoadPrimaryAsset(
+		Id, TArray<FName>(), FStreamableDelegate::CreateUObject(this, &ThisClass::HandleDefinitionLoaded, Id));
+
+	if (!Handle.IsValid())
+	{
+		LOG_WARNING("UDaItemDefinitionCache: %s is not a known primary asset — is ItemDefinition in PrimaryAssetTypesToScan?", *Id.ToString());
+		HandleDefinitionLoaded(Id);
+		return;
+	}
+
+	// Still waiting (the inline-completion case has already cleared PendingCallbacks).
+	if (PendingCallbacks.Contains(Id))
+	{
+		PendingLoads.Add(Id, Handle);
+	}
+	UpdateStats();
+}
+
+void UDaItemDefinitionCache::PreloadDefinitions(const TArray<FPrimaryAssetId>& Ids)
+{
+	for (const FPrimaryAssetId& Id : Ids)
+	{
+		if (Id.IsValid() && !Definitions.Contains(Id) && !PendingCallbacks.Contains(Id))
+		{
+			RequestDefinition(Id, FDaItemDefinitionLoaded());
+		}
+	}
+}
+
+UDaItemDefinition* UDaItemDefinitionCache::LoadDefinitionBlocking(const FPrimaryAssetId& Id)
+{
+	if (UDaItemDefinition* Def = FindDefinition(Id))
+	{
+		return Def;
+	}
+
+	if (!Id.IsValid())
+	{
+		return nullptr;
+	}
+
+	++Stats.BlockingLoads;
+	INC_DWORD_STAT(STAT_DaItemDefCacheBlockingLoads);
+
+	// An async load is already under way: finish it rather than starting a second, parallel one.
+	if (const TSharedPtr<FStreamableHandle>* Pending = PendingLoads.Find(Id))
+	{
+		const TSharedPtr<FStreamableHandle> Handle = *Pending;
+		Handle->WaitUntilComplete();
+		// The completion delegate may still be queued; pin the result now and let it run the callbacks.
+		if (UDaItemDefinition* Loaded = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(Id)))
+		{
+			StoreDefinition(Id, Loaded);
+			return Loaded;
+		}
+	}
+
+	UDaItemDefinition* Def = nullptr;
+	const FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(Id);
+	if (AssetPath.IsValid())
+	{
+		Def = Cast<UDaItemDefinition>(AssetPath.TryLoad());
+	}
+
+	if (Def)
+	{
+		LOG("UDaItemDefinitionCache: blocking load of %s — preload it to avoid the hitch", *Id.ToString());
+		StoreDefinition(Id, Def);
+	}
+	return Def;
+}
+
+void UDaItemDefinitionCache::AddHeldReference(const FPrimaryAssetId& Id)
+{
+	if (!Id.IsValid())
+	{
+		return;
+	}
+
+	FHeldItem& Held = HeldItems.FindOrAdd(Id);
+	if (++Held.RefCount > 1)
+	{
+		return;
+	}
+
+	if (const TObjectPtr<UDaItemDefinition>* Found = Definitions.Find(Id))
+	{
+		StreamHeldAssets(Id, **Found);
+	}
+	else
+	{
+		// StoreDefinition streams the soft assets once the definition lands, if it is still held.
+		RequestDefinition(Id, FDaItemDefinitionLoaded());
+	}
+	UpdateStats();
+}
+
+void UDaItemDefinitionCache::RemoveHeldReference(const FPrimaryAssetId& Id)
+{
+	FHeldItem* Held = HeldItems.Find(Id);
+	if (!Held || --Held->RefCount > 0)
+	{
+		return;
+	}
+
+	if (Held->AssetsHandle.IsValid())
+	{
+		Held->AssetsHandle->ReleaseHandle();
+	}
+	HeldItems.Remove(Id);
+	UpdateStats();
+}
+
+FDaItemDefinitionCacheStats UDaItemDefinitionCache::GetStats() const
+{
+	UpdateStats();
+	return Stats;
+}
+
+void UDaItemDefinitionCache::Deinitialize()
+{
+	for (TPair<FPrimaryAssetId, TSharedPtr<FStreamableHandle>>& Pair : PendingLoads)
+	{
+		if (Pair.Value.IsValid())
+		{
+			Pair.Value->CancelHandle();
+		}
+	}
+	for (TPair<FPrimaryAssetId, FHeldItem>& Pair : HeldItems)
+	{
+		if (Pair.Value.AssetsHandle.IsValid())
+		{
+			Pair.Value.AssetsHandle->ReleaseHandle();
+		}
+	}
+
+	PendingLoads.Empty();
+	PendingCallbacks.Empty();
+	HeldItems.Empty();
+	Definitions.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDaItemDefinitionCache::HandleDefinitionLoaded(FPrimaryAssetId Id)
+{
+	PendingLoads.Remove(Id);
+
+	UDaItemDefinition* Def = Cast<UDaItemDefinition>(UAssetManager::Get().GetPrimaryAssetObject(Id));
+	if (Def)
+	{
+		StoreDefinition(Id, Def);
+	}
+	else
+	{
+		LOG_WARNING("UDaItemDefinitionCache: failed to load item definition %s", *Id.ToString());
+	}
+
+	// Removed before running: a callback may request this same id again.
+	TArray<FDaItemDefinitionLoaded> Callbacks;
+	PendingCallbacks.RemoveAndCopyValue(Id, Callbacks);
+	for (FDaItemDefinitionLoaded& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(Def);
+	}
+	UpdateStats();
+}
+
+void UDaItemDefinitionCache::StoreDefinition(const FPrimaryAssetId& Id, UDaItemDefinition* Def)
+{
+	const bool bNew = !Definitions.Contains(Id);
+	Definitions.Add(Id, Def);
+
+	const FHeldItem* Held = HeldItems.Find(Id);
+	if (bNew && Held && Held->RefCount > 0 && !Held->AssetsHandle.IsValid())
+	{
+		StreamHeldAssets(Id, *Def);
+	}
+	UpdateStats();
+}
+
+void UDaItemDefinitionCache::StreamHeldAssets(const FPrimaryAssetId& Id, const UDaItemDefinition& Def)
+{
+	TArray<FSoftObjectPath> Paths;
+	const FSoftObjectPath Candidates[] = {
+		Def.Icon.ToSoftObjectPath(),
+		Def.DisplayMesh.ToSoftObjectPath(),
+		Def.PickupActorClass.ToSoftObjectPath(),
+		Def.AbilitySetToGrant.ToSoftObjectPath(),
+	};
+	for (const FSoftObjectPath& Path : Candidates)
+	{
+		if (Path.IsValid())
+		{
+			Paths.Add(Path);
+		}
+	}
+
+	if (Paths.Num() == 0)
+	{
+		return;
+	}
+
+	if (FHeldItem* Held = HeldItems.Find(Id))
+	{
+		Held->AssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths));
+	}
+}
+
+void UDaItemDefinitionCache::UpdateStats() const
+{
+	Stats.Resident = Definitions.Num();
+	Stats.Pending = PendingCallbacks.Num();
+	Stats.Held = HeldItems.Num();
+
+	SET_DWORD_STAT(STAT_DaItemDefCacheResident, Stats.Resident);
+	SET_DWORD_STAT(STAT_DaItemDefCachePending, Stats.Pending);
+}
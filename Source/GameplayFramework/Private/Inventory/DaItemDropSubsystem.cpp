@@ -0,0 +1,182 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "Inventory/DaItemDropSubsystem.h"
+
+#include "DaItemActor.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameplayFramework.h"
+
+static TAutoConsoleVariable<int32> CVarMaxDropSpawnsPerFrame(TEXT("da.MaxDropSpawnsPerFrame"), 4, TEXT("Maximum dropped-item pickups spawned per frame; the rest wait in the drop queue (<= 0 means unlimited)"), ECVF_Default);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Drop Queue Depth"), STAT_DaDropQueueDepth, STATGROUP_DAGF);
+
+UDaItemDropSubsystem* UDaItemDropSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = (GEngine && WorldContextObject)
+		? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull)
+		: nullptr;
+	return World ? World->GetSubsystem<UDaItemDropSubsystem>() : nullptr;
+}
+
+void UDaItemDropSubsystem::QueueDrop(const FDaInventoryEntry& Entry, bool bWholeInstance, const FTransform& SpawnTransform,
+	const TSoftClassPtr<ADaItemActor>& PickupClass, const TSoftObjectPtr<UStaticMesh>& DisplayMesh)
+{
+	FPendingDrop Drop;
+	Drop.Entry = Entry;
+	Drop.bWholeInstance = bWholeInstance;
+	Drop.SpawnTransform = SpawnTransform;
+	Drop.PickupClass = PickupClass;
+	Drop.DisplayMesh = DisplayMesh;
+
+	// Only stream what is not resident yet. Held items normally have both already (the definition
+	// cache streams them while the item sits in an inventory), in which case nothing is requested.
+	TArray<FSoftObjectPath> ToLoad;
+	if (!PickupClass.IsNull() && !PickupClass.Get())
+	{
+		ToLoad.Add(PickupClass.ToSoftObjectPath());
+	}
+	if (!DisplayMesh.IsNull() && !DisplayMesh.Get())
+	{
+		ToLoad.Add(DisplayMesh.ToSoftObjectPath());
+	}
+	if (ToLoad.Num() > 0)
+	{
+		Drop.AssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(ToLoad));
+	}
+
+	// Spawn now when nothing has to load and the frame has budget left; FIFO order is kept by only
+	// taking the inline path while nothing older is waiting.
+	if (PendingDrops.Num() == 0 && Drop.IsReady() && ConsumeSpawnBudget())
+	{
+		SpawnDrop(Drop);
+		return;
+	}
+
+	PendingDrops.Add(MoveTemp(Drop));
+	UpdateQueueStat();
+}
+
+void UDaItemDropSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Ready drops spawn in the order they were accepted; one still streaming does not hold back
+	// the ones behind it.
+	for (int32 Index = 0; Index < PendingDrops.Num(); )
+	{
+		if (!PendingDrops[Index].IsReady())
+		{
+			++Index;
+			continue;
+		}
+		if (!ConsumeSpawnBudget())
+		{
+			break;
+		}
+
+		const FPendingDrop Drop = MoveTemp(PendingDrops[Index]);
+		PendingDrops.RemoveAt(Index);
+		SpawnDrop(Drop);
+	}
+	UpdateQueueStat();
+}
+
+TStatId UDaItemDropSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDaItemDropSubsystem, STATGROUP_Tickables);
+}
+
+void UDaItemDropSubsystem::Deinitialize()
+{
+	if (PendingDrops.Num() > 0)
+	{
+		LOG_WARNING("UDaItemDropSubsystem: world torn down with %d dropped item(s) still waiting to spawn", PendingDrops.Num());
+	}
+	for (FPendingDrop& Drop : PendingDrops)
+	{
+		if (Drop.AssetsHandle.IsValid())
+		{
+			Drop.AssetsHandle->CancelHandle();
+		}
+	}
+	PendingDrops.Empty();
+	UpdateQueueStat();
+
+	Super::Deinitialize();
+}
+
+bool UDaItemDropSubsystem::FPendingDrop::IsReady() const
+{
+	return !AssetsHandle.IsValid() || AssetsHandle->HasLoadCompleted() || AssetsHandle->WasCanceled();
+}
+
+bool UDaItemDropSubsystem::ConsumeSpawnBudget()
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		SpawnsThisFrame = 0;
+	}
+
+	const int32 MaxPerFrame = CVarMaxDropSpawnsPerFrame.GetValueOnGameThread();
+	if (MaxPerFrame > 0 && SpawnsThisFrame >= MaxPerFrame)
+	{
+		return false;
+	}
+	++SpawnsThisFrame;
+	return true;
+}
+
+void UDaItemDropSubsystem::SpawnDrop(const FPendingDrop& Drop)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// The entry has already left the inventory, so a pickup class that failed to load must not
+	// lose the item: fall back to the plain actor rather than dropping nothing.
+	UClass* PickupClass = Drop.PickupClass.Get();
+	if (!PickupClass)
+	{
+		if (!Drop.PickupClass.IsNull())
+		{
+			LOG_WARNING("UDaItemDropSubsystem: failed to load PickupActorClass %s for %s, spawning ADaItemActor",
+				*Drop.PickupClass.ToString(), *Drop.Entry.ItemDefinitionID.ToString());
+		}
+		PickupClass = ADaItemActor::StaticClass();
+	}
+
+	// A single pickup actor represents the whole dropped stack
+	ADaItemActor* Pickup = World->SpawnActorDeferred<ADaItemActor>(PickupClass, Drop.SpawnTransform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!Pickup)
+	{
+		LOG_WARNING("UDaItemDropSubsystem: failed to spawn pickup for %s", *Drop.Entry.ItemDefinitionID.ToString());
+		return;
+	}
+
+	if (Drop.bWholeInstance)
+	{
+		// The instance left the inventory whole, so hand the actor its entry: picking it back
+		// up restores this same item, per-instance stats and all.
+		Pickup->InitializeDroppedItem(Drop.Entry, Drop.DisplayMesh.Get());
+	}
+	else
+	{
+		// A partial stack leaves the original entry (and its ItemID) behind in the inventory,
+		// so what hits the ground is a new instance and gets a fresh ID on pickup.
+		Pickup->InitializeDroppedItem(Drop.Entry.ItemDefinitionID, Drop.DisplayMesh.Get());
+	}
+	Pickup->FinishSpawning(Drop.SpawnTransform);
+}
+
+void UDaItemDropSubsystem::UpdateQueueStat() const
+{
+	SET_DWORD_STAT(STAT_DaDropQueueDepth, PendingDrops.Num());
+}
@@ -262,9 +262,9 @@ void UDaHotbarWidget::RebuildSlotStates()
 			continue;
 		}
 
-		// Everything the slot shows comes off the same view-model the inventory panel uses, so the
-		// two views of one item cannot disagree.
-		if (UDaInventoryItemBase* Item = UDaInventoryItemBase::CreateFromEntry(*Entry, this))
+		// Everything the slot shows comes off the same pooled view-model the inventory panel uses,
+		// so the two views of one item cannot disagree.
+		if (UDaInventoryItemBase* Item = Inventory->FindOrCreateItemViewModel(*Entry))
 		{
 			State.ItemID = ItemID;
 			State.bAssigned = true;
@@ -74,6 +74,7 @@ void UDaWidgetController::BroadcastAttributeInfo(const FGameplayTag& AttributeTa
 {
 	check(AttributeInfo);
 	
+	// Copy, the broadcast carries this attribute's current value
 	FDaAttributeData AttributeData = AttributeInfo->FindAttributeInfoForTag(AttributeTag);
 	AttributeData.AttributeValue = Attribute.GetNumericValue(AttributeSet);
 	AttributeInfoDelegate.Broadcast(AttributeData);
@@ -8,6 +8,17 @@
 #include "Components/SizeBox.h"
 #include "Kismet/GameplayStatics.h"
 
+void UDaWorldUserWidget::SetAttachedActor(AActor* NewActor)
+{
+	if (AttachedActor == NewActor)
+	{
+		return;
+	}
+
+	AttachedActor = NewActor;
+	OnAttachedActorChanged(NewActor);
+}
+
 void UDaWorldUserWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
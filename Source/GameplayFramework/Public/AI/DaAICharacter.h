@@ -24,6 +24,9 @@ public:
 	ADaAICharacter();
 	
 	virtual void InitAbilitySystem() override;
+
+	/** Tags this bot is counted under in UDaBotRegistrySubsystem (character type and ID). */
+	FGameplayTagContainer GetRegistryTags() const;
 	
 protected:
 
@@ -71,6 +74,8 @@ protected:
 	void PlayerSeenWidgetTimeExpired();
 	
 	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// override so AI character can set blackboard keys, still calls super to handle health change
 	virtual void OnHealthChanged(UDaAttributeComponent* HealthComponent, float OldHealth, float NewHealth, AActor* InstigatorActor) override;
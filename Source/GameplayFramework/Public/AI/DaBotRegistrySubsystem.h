@@ -0,0 +1,85 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DaBotRegistrySubsystem.generated.h"
+
+class ADaAICharacter;
+
+/**
+ * UDaBotRegistrySubsystem
+ *
+ * Every ADaAICharacter in the world, split into alive and dead (dying/ragdolling, not yet
+ * destroyed), with live counts per monster row and per gameplay tag. Bots join on BeginPlay, move
+ * to dead on OnDeathStarted and leave on EndPlay, so the spawn manager's "how many are alive" and
+ * "kill them all" no longer scan every actor in the world with TActorRange.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaBotRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UDaBotRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	void RegisterBot(ADaAICharacter* Bot);
+	void UnregisterBot(ADaAICharacter* Bot);
+
+	/** Bot started dying: it stops counting as alive but stays iterable as dead until EndPlay. */
+	void MarkBotDead(ADaAICharacter* Bot);
+
+	/** Record which monster row (FMonsterInfoRow::MonsterId) Bot was spawned from. */
+	void SetBotMonsterId(ADaAICharacter* Bot, const FPrimaryAssetId& MonsterId);
+
+	UFUNCTION(BlueprintPure, Category="AI|Registry")
+	int32 GetAliveCount() const { return AliveBots.Num(); }
+
+	UFUNCTION(BlueprintPure, Category="AI|Registry")
+	int32 GetDeadCount() const { return DeadBots.Num(); }
+
+	/** Alive bots spawned from MonsterId's row. */
+	UFUNCTION(BlueprintPure, Category="AI|Registry")
+	int32 GetAliveCountForMonster(FPrimaryAssetId MonsterId) const;
+
+	/** Alive bots whose character type or ID tag matches Tag (parents match children). */
+	UFUNCTION(BlueprintPure, Category="AI|Registry")
+	int32 GetAliveCountForTag(FGameplayTag Tag) const;
+
+	/** Snapshot of the alive bots, safe to hold across kills. */
+	UFUNCTION(BlueprintCallable, Category="AI|Registry")
+	TArray<ADaAICharacter*> GetAliveBots() const;
+
+	/** Visit the alive / dead bots. Do not register, unregister or kill from inside Visit; take
+	 *  GetAliveBots() instead when the loop body can change the registry. */
+	void ForEachAliveBot(TFunctionRef<void(ADaAICharacter&)> Visit) const;
+	void ForEachDeadBot(TFunctionRef<void(ADaAICharacter&)> Visit) const;
+
+private:
+
+	struct FBotRecord
+	{
+		bool bAlive = true;
+
+		/** Position in AliveBots or DeadBots, per bAlive. */
+		int32 Index = INDEX_NONE;
+
+		FPrimaryAssetId MonsterId;
+		FGameplayTagContainer Tags;
+	};
+
+	void AddToList(ADaAICharacter* Bot, FBotRecord& Record, bool bAlive);
+	void RemoveFromList(FBotRecord& Record);
+	void AdjustAliveCounts(const FBotRecord& Record, int32 Delta);
+
+	TArray<TWeakObjectPtr<ADaAICharacter>> AliveBots;
+	TArray<TWeakObjectPtr<ADaAICharacter>> DeadBots;
+	TMap<TObjectKey<ADaAICharacter>, FBotRecord> Records;
+
+	TMap<FPrimaryAssetId, int32> AliveByMonster;
+	TMap<FGameplayTag, int32> AliveByTag;
+};
@@ -66,6 +66,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Attack")
 	TSubclassOf<AActor> ProjectileClass;
 
+	/* Fly ProjectileClass as a struct in UDaProjectileSimulationSubsystem instead of as an actor. For high volume fire; flights are server only and not replicated */
+	UPROPERTY(EditAnywhere, Category = "Attack")
+	bool bUseBatchedSimulation = false;
+
+	/* Projectiles of ProjectileClass parked in the pool when the ability is granted, so the first volley does not spawn */
+	UPROPERTY(EditAnywhere, Category = "Attack", meta=(ClampMin=0))
+	int32 PoolPrewarmCount = 0;
+
 	/* Particle System played during attack animation */
 	UPROPERTY(EditAnywhere, Category = "Attack")
 	TObjectPtr<UParticleSystem> CastingEffect;
@@ -80,6 +88,7 @@ protected:
 	UFUNCTION()
 	void AnimNotifyEventCallback(FGameplayEventData Payload);
 	
+	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override;
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 
@@ -38,7 +38,14 @@ class GAMEPLAYFRAMEWORK_API UDaAttributeInfo : public UPrimaryDataAsset
 
 public:
 
-	FDaAttributeData FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound = false) const;
+	/** Info for AttributeTag, or an empty struct when the asset has none. O(1) through the tag index. */
+	const FDaAttributeData& FindAttributeInfoForTag(const FGameplayTag& AttributeTag, bool bLogNotFound = false) const;
+
+	/** Resolve several tags in one call: OutInfos[i] is the info for AttributeTags[i], nullptr when missing. */
+	void FindAttributeInfoForTags(TConstArrayView<FGameplayTag> AttributeTags, TArray<const FDaAttributeData*>& OutInfos, bool bLogNotFound = false) const;
+
+	/** Rebuild the tag index, needed only after changing AttributeInfo from code. */
+	void RebuildTagIndex() const;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TArray<FDaAttributeData> AttributeInfo;
@@ -47,4 +54,18 @@ public:
 	{
 		return FPrimaryAssetId("AttributeInfoAssetId", GetFName());
 	}
+
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	const FDaAttributeData* FindInfo(const FGameplayTag& AttributeTag, bool bLogNotFound) const;
+
+	// AttributeInfo index by tag, built on first lookup
+	mutable TMap<FGameplayTag, int32> TagToIndex;
+	mutable bool bTagIndexBuilt = false;
 };
@@ -16,6 +16,38 @@ struct FDynamicAttributeDefinition
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attributes")
 	float DefaultValue = 0.0f; // Default value for this attribute
+
+	// DynamicNN property this attribute lives in, assigned once when it is first compiled in the editor so
+	// reordering or removing definitions never retargets GameplayEffects that picked the slot
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Attributes")
+	int32 Slot = INDEX_NONE;
+};
+
+/**
+ * FDaDynamicAttributeLayout
+ *
+ * Attributes of a UDaAttributeSetDataAsset compiled to fixed indices: each valid definition lives in
+ * the UDaDynamicAttributeSet slot it was assigned, definitions without one take the lowest free slot.
+ * Unnamed and duplicate definitions, and any that find no slot below MaxAttributes, are dropped with a
+ * warning. Slots no definition claims stay empty (NAME_None), so Num() is one past the highest slot.
+ */
+struct GAMEPLAYFRAMEWORK_API FDaDynamicAttributeLayout
+{
+	/** Slots UDaDynamicAttributeSet has room for. */
+	static constexpr int32 MaxAttributes = 32;
+
+	// By slot, NAME_None for an empty one
+	TArray<FName> Names;
+	TArray<float> DefaultValues;
+	TMap<FName, int32> IndexByName;
+
+	int32 Num() const { return Names.Num(); }
+
+	int32 FindIndex(FName AttributeName) const
+	{
+		const int32* Index = IndexByName.Find(AttributeName);
+		return Index ? *Index : INDEX_NONE;
+	}
 };
 
 /**
@@ -30,5 +62,18 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Attributes")
 	TArray<FDynamicAttributeDefinition> Attributes;
-	
+
+	/** Attributes compiled to slot indices, built on first use. */
+	const FDaDynamicAttributeLayout& GetLayout() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	void CompileLayout() const;
+
+	mutable FDaDynamicAttributeLayout Layout;
+	mutable bool bLayoutCompiled = false;
 };
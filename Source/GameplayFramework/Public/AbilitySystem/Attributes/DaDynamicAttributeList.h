@@ -0,0 +1,77 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "DaDynamicAttributeList.generated.h"
+
+class UDaDynamicAttributeSet;
+
+struct FDaDynamicAttributeList;
+
+/**
+ * FDaDynamicAttributeEntry
+ * Replicated value of one UDaDynamicAttributeSet slot, re-sent only when that slot changes.
+ */
+USTRUCT()
+struct GAMEPLAYFRAMEWORK_API FDaDynamicAttributeEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	// Slot in UDaDynamicAttributeSet, i.e. index in the compiled layout
+	UPROPERTY()
+	uint8 Slot = 0;
+
+	UPROPERTY()
+	float BaseValue = 0.0f;
+
+	UPROPERTY()
+	float CurrentValue = 0.0f;
+
+	// ----- FastArraySerializer callbacks -----
+
+	void PostReplicatedAdd(const FDaDynamicAttributeList& InArraySerializer);
+	void PostReplicatedChange(const FDaDynamicAttributeList& InArraySerializer);
+};
+
+/**
+ * FDaDynamicAttributeList
+ *
+ * FFastArraySerializer wrapper owning the replicated slot values of a UDaDynamicAttributeSet.
+ */
+USTRUCT()
+struct GAMEPLAYFRAMEWORK_API FDaDynamicAttributeList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	FDaDynamicAttributeList()
+		: OwnerSet(nullptr)
+	{
+	}
+
+	// ----- Serialisation -----
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FDaDynamicAttributeEntry, FDaDynamicAttributeList>(Entries, DeltaParms, *this);
+	}
+
+	// The replicated item array, one entry per slot in layout order on the server
+	UPROPERTY()
+	TArray<FDaDynamicAttributeEntry> Entries;
+
+	// Owning set — set on construction, never replicated.
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UDaDynamicAttributeSet> OwnerSet;
+};
+
+/** Enable NetDeltaSerialize for FDaDynamicAttributeList. */
+template<>
+struct TStructOpsTypeTraits<FDaDynamicAttributeList> : public TStructOpsTypeTraitsBase2<FDaDynamicAttributeList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
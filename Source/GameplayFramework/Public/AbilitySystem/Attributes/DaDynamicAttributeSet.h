@@ -5,11 +5,27 @@
 #include "CoreMinimal.h"
 #include "AttributeSet.h"
 #include "DaBaseAttributeSet.h"
+#include "AbilitySystem/Attributes/DaDynamicAttributeList.h"
 #include "DaDynamicAttributeSet.generated.h"
 
 class UDaAttributeSetDataAsset;
+struct FDaDynamicAttributeLayout;
+
 /**
- * 
+ * UDaDynamicAttributeSet
+ *
+ * Attribute set whose attributes come from a UDaAttributeSetDataAsset. The asset's definitions are
+ * compiled to a fixed layout (FDaDynamicAttributeLayout) and the Nth attribute lives in the Nth
+ * DynamicNN property, so each one is a real FGameplayAttribute that GameplayEffects, MMC captures
+ * and attribute change delegates work with like any hand-written attribute. In a GameplayEffect
+ * pick DaDynamicAttributeSet.DynamicNN, N being the Slot the asset shows for the attribute.
+ *
+ * One per ASC: GAS resolves an FGameplayAttribute to the first set of its class on the ASC, so
+ * GameplayEffects and delegates only ever see that one. A second set still holds its own values
+ * through the accessors below, but effects and change delegates do not reach it.
+ *
+ * Resolve names to an index once (FindAttributeIndex) and use the index accessors on hot paths.
+ * Values reach clients as a FastArray delta, so only the slots that changed are sent.
  */
 UCLASS()
 class GAMEPLAYFRAMEWORK_API UDaDynamicAttributeSet : public UDaBaseAttributeSet
@@ -18,14 +34,154 @@ class GAMEPLAYFRAMEWORK_API UDaDynamicAttributeSet : public UDaBaseAttributeSet
 
 public:
 
-	// Map to hold dynamically defined attributes
-	TMap<FName, FGameplayAttributeData> DynamicAttributes;
+	UDaDynamicAttributeSet();
+
+	/** Compile DataAsset's definitions and set every attribute to its default. Authority only, after the set is added to its ASC. */
+	void InitializeAttributes(const UDaAttributeSetDataAsset* DataAsset);
+
+	/** Index of AttributeName in the compiled layout, INDEX_NONE when it is not defined. */
+	int32 FindAttributeIndex(FName AttributeName) const;
+
+	/** Slots in the compiled layout, empty ones (no definition claims them) included. */
+	int32 GetNumAttributes() const;
+
+	const UDaAttributeSetDataAsset* GetDefinition() const { return Definition; }
+
+	/** Attribute handle of a layout index, for GameplayEffect modifiers and MMC capture definitions. */
+	static FGameplayAttribute GetAttributeForIndex(int32 Index);
+
+	/** Attribute handle by name, invalid when AttributeName is not defined. */
+	FGameplayAttribute GetAttributeHandle(FName AttributeName) const;
 
 	// Access attribute by name
 	float GetAttributeValue(FName AttributeName) const;
 	void SetAttributeValue(FName AttributeName, float NewValue);
 
-	// Initialize attributes from a Data Asset
-	void InitializeAttributes(UDaAttributeSetDataAsset* DataAsset);
-	
+	// Access attribute by layout index
+	float GetAttributeValueByIndex(int32 Index) const;
+	void SetAttributeValueByIndex(int32 Index, float NewValue);
+
+	// UAttributeSet
+	virtual void PostAttributeChange(const FGameplayAttribute& Attribute, float OldValue, float NewValue) override;
+
+protected:
+
+	friend struct FDaDynamicAttributeEntry;
+
+	/** Client side: copy a replicated slot into its attribute and let the ASC broadcast the change. */
+	void HandleReplicatedEntry(const FDaDynamicAttributeEntry& Entry);
+
+	/** Server side: copy slot Index into its replicated entry and mark it dirty if it changed. */
+	void UpdateReplicatedEntry(int32 Index);
+
+	FGameplayAttributeData* GetSlotData(int32 Index);
+	const FGameplayAttributeData* GetSlotData(int32 Index) const;
+
+	/** Whether the ASC resolves this class's attributes to this set, i.e. it is the first of its class there. */
+	bool IsResolvedByASC(const UAbilitySystemComponent* ASC) const;
+
+	UPROPERTY(Replicated)
+	TObjectPtr<const UDaAttributeSetDataAsset> Definition;
+
+	UPROPERTY(Replicated)
+	FDaDynamicAttributeList ReplicatedValues;
+
+private:
+
+	// Storage for the compiled layout, slot N holds layout index N. Replicated through ReplicatedValues.
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic00;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic01;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic02;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic03;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic04;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic05;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic06;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic07;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic08;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic09;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic10;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic11;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic12;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic13;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic14;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic15;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic16;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic17;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic18;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic19;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic20;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic21;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic22;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic23;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic24;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic25;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic26;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic27;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic28;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic29;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic30;
+
+	UPROPERTY(BlueprintReadOnly, Category = "DA|Dynamic", Meta = (AllowPrivateAccess = true))
+	FGameplayAttributeData Dynamic31;
 };
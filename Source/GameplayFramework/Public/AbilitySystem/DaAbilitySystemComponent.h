@@ -4,16 +4,44 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "AbilitySystem/DaAbilitySet.h"
 #include "DaAbilitySystemComponent.generated.h"
 
 class UDaBaseAttributeSet;
 class UDaAbilitySet;
 struct FInputActionValue;
 class UDaInputConfig;
-struct FDaAbilitySet_GrantedHandles;
 class UDaPawnData;
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FEffectAssetTags, const FGameplayTagContainer& /*AssetTags*/)
+
+/* Effects with the same asset tags applied within one batch window, sent to the owning client together */
+USTRUCT()
+struct FDaEffectAppliedBatchEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTagContainer AssetTags;
+
+	UPROPERTY()
+	int32 Count = 0;
+};
+
+/* What one ability set granted, kept until the last GrantSet holding it is revoked */
+USTRUCT()
+struct FDaGrantedAbilitySet
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FDaAbilitySet_GrantedHandles Handles;
+
+	/* GrantSet calls not yet matched by RevokeSet; the set is only given once */
+	UPROPERTY()
+	int32 GrantCount = 0;
+};
+
 /**
  * 
  */
@@ -24,12 +52,18 @@ class GAMEPLAYFRAMEWORK_API UDaAbilitySystemComponent : public UAbilitySystemCom
 
 protected:
 
+	/* Everything granted through GrantSet / InitAbilitiesWithPawnData, by set */
 	UPROPERTY()
-	TArray<FDaAbilitySet_GrantedHandles> OutGrantedAbilityHandlesArray;
-	// TODO: Make this a map so we can remove individual AbilitySets later ex. TSet<FDaAbilitySet_GrantedHandles, FGameplayTag> AbilitySets;
+	TMap<TObjectPtr<const UDaAbilitySet>, FDaGrantedAbilitySet> GrantedAbilitySets;
 
+	/* One RPC per batch window instead of one per applied effect; da.EffectNotifyBatchWindow / da.EffectNotifyMaxBatch */
 	UFUNCTION(Client, Reliable)
-	void ClientEffectApplied(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle);
+	void ClientEffectsApplied(const TArray<FDaEffectAppliedBatchEntry>& Batch);
+
+	void HandleEffectAppliedToSelf(UAbilitySystemComponent* AbilitySystemComponent, const FGameplayEffectSpec& EffectSpec, FActiveGameplayEffectHandle ActiveEffectHandle);
+
+	/* Send the pending batch to the owning client now */
+	void FlushEffectBatch();
 	
 public:
 	UFUNCTION(BlueprintPure, Category = "DA|AbilitySystem")
@@ -45,13 +79,65 @@ public:
 	UFUNCTION(Server, Reliable)
 	void ServerUpgradeAttribute(const FGameplayTag& AttributeTag, int32 Amount);
 	
+	/** Give AbilitySet, or count one more holder if it is already granted. Server only. */
 	void GrantSet(const UDaAbilitySet* AbilitySet);
+
+	/** Release one GrantSet of AbilitySet; the last release takes away what it granted. Server only. */
+	void RevokeSet(const UDaAbilitySet* AbilitySet);
+
+	bool HasAbilitySet(const UDaAbilitySet* AbilitySet) const { return GrantedAbilitySets.Contains(AbilitySet); }
+	int32 GetNumGrantedAbilitySets() const { return GrantedAbilitySets.Num(); }
 	
 	void AbilityInputTagPressed(const FInputActionValue& Value, const FGameplayTag& InputTag);
 	void AbilityInputTagHeld(const FGameplayTag InputTag);
 	void AbilityInputTagReleased(const FGameplayTag InputTag);
 
+	/** Re-index Handle after changing its dynamic spec source tags; GAS has no notification for that. */
+	void RefreshAbilityInputTags(FGameplayAbilitySpecHandle Handle);
+
 	void AbilityActorInfoSet();
 	
 	UDaBaseAttributeSet* GetAttributeSetForTag(const FGameplayTag& SetIdentifierTag) const;
+
+protected:
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRep_ActivateAbilities() override;
+
+private:
+
+	/** A spec under an input tag, with where it last sat in ActivatableAbilities to skip the handle search. */
+	struct FInputTagSpec
+	{
+		FGameplayAbilitySpecHandle Handle;
+		int32 ItemIndex = INDEX_NONE;
+	};
+
+	using FInputTagSpecList = TArray<FInputTagSpec, TInlineAllocator<4>>;
+
+	void IndexAbilitySpec(const FGameplayAbilitySpec& AbilitySpec, int32 ItemIndex);
+	void UnindexAbilitySpec(FGameplayAbilitySpecHandle Handle);
+	void RebuildInputTagIndex();
+
+	/** Snapshot of the specs indexed under InputTag; a copy, so activation may give or clear abilities. */
+	void GetSpecsForInputTag(const FGameplayTag& InputTag, FInputTagSpecList& OutSpecs) const;
+	FGameplayAbilitySpec* FindIndexedSpec(const FInputTagSpec& Entry);
+
+#if !UE_BUILD_SHIPPING
+	/** da.ValidateAbilityInputIndex: compare the index for InputTag against a full scan, rebuild on mismatch. */
+	void ValidateInputTagIndex(const FGameplayTag& InputTag);
+#endif
+
+	/** Every dynamic spec source tag of the activatable abilities, to the specs carrying it. */
+	TMap<FGameplayTag, FInputTagSpecList> InputTagToSpecs;
+
+	/** Tags each spec is indexed under, so removing it does not search the whole map. */
+	TMap<FGameplayAbilitySpecHandle, FGameplayTagContainer> IndexedSpecTags;
+
+	/** Effect asset tags waiting for the next FlushEffectBatch, deduplicated with counts. */
+	TArray<FDaEffectAppliedBatchEntry> PendingEffectBatch;
+	int32 PendingEffectCount = 0;
+	FTimerHandle EffectBatchTimerHandle;
 };
@@ -41,6 +41,33 @@ public:
 	float KillReward;
 };
 
+UENUM(BlueprintType)
+enum class EDaMonsterSelectionMode : uint8
+{
+	// Every row equally likely (the original behaviour)
+	Uniform,
+
+	// Rows picked in proportion to FMonsterInfoRow::Weight, among those the wave budget can afford
+	Weighted
+};
+
+/**
+ * FDaAliasTable
+ * Vose alias table: after an O(n) build, draws an index with probability proportional to its
+ * weight in O(1) (one bucket pick, one coin flip).
+ */
+struct GAMEPLAYFRAMEWORK_API FDaAliasTable
+{
+	// Weights must be > 0
+	void Build(TConstArrayView<float> Weights);
+	int32 Sample(const FRandomStream& Stream) const;
+	bool IsEmpty() const { return Probability.Num() == 0; }
+
+private:
+	TArray<float> Probability;
+	TArray<int32> Alias;
+};
+
 /**
  * 
  */
@@ -84,12 +111,41 @@ public:
 
 	UFUNCTION(BlueprintCallable)
 	void KillAllBots();
-	
+
+	/** Swap the monster table; the cached rows and alias tables are rebuilt on next use. */
+	UFUNCTION(BlueprintCallable, Category="AI")
+	void SetMonsterTable(UDataTable* NewMonsterTable);
+
+	/** Reseed monster selection. The same seed, table and budget curve reproduce the same sequence
+	 *  of picks, which is what benchmarks and wave repro need. */
+	UFUNCTION(BlueprintCallable, Category="AI")
+	void SetSelectionSeed(int32 NewSeed);
+
+	/** Budget the current wave has left to spend on SpawnCost; negative when unbudgeted. */
+	UFUNCTION(BlueprintPure, Category="AI")
+	float GetWaveBudgetRemaining() const { return WaveBudgetRemaining; }
+
 protected:
 	
 	UPROPERTY(EditDefaultsOnly, Category="AI")
 	TObjectPtr<UDataTable> MonsterTable;
 
+	UPROPERTY(EditDefaultsOnly, Category="AI")
+	EDaMonsterSelectionMode SelectionMode = EDaMonsterSelectionMode::Weighted;
+
+	// Seed for monster selection. 0 picks a fresh seed each StartSpawning
+	UPROPERTY(EditDefaultsOnly, Category="AI")
+	int32 SelectionSeed = 0;
+
+	// Total SpawnCost each wave may spend, by wave number (0, 1, 2...). Unset means unbudgeted:
+	// only MaxBotCount limits spawning
+	UPROPERTY(EditDefaultsOnly, Category="AI")
+	TObjectPtr<UCurveFloat> WaveBudgetCurve;
+
+	// Length of a budget wave in seconds; the budget refills from WaveBudgetCurve at each new wave
+	UPROPERTY(EditDefaultsOnly, Category="AI", meta=(ClampMin="1.0", EditCondition="WaveBudgetCurve != nullptr"))
+	float WaveDuration = 30.0f;
+
 	UPROPERTY(EditDefaultsOnly, Category="AI")
 	TObjectPtr<UCurveFloat> DifficultyCurve;
 
@@ -108,7 +164,34 @@ protected:
 	void SpawnBotTimerElapsed();
 	
 	void OnMonsterLoaded(FPrimaryAssetId LoadedId, FVector SpawnLocation);
-	
+
+	/** Rebuild CachedRows and the alias tables if MonsterTable changed since they were built. */
+	void EnsureSelectionTables();
+	void HandleMonsterTableChanged();
+
+	/** Move to the current wave, refilling WaveBudgetRemaining when it starts. */
+	void UpdateWaveBudget();
+
+	/** Index into CachedRows of the next monster to spawn, or INDEX_NONE if none is affordable. */
+	int32 SelectMonsterRow();
+
+	/** MonsterTable rows, copied once per table load and sorted by ascending SpawnCost. */
+	TArray<FMonsterInfoRow> CachedRows;
+
+	/** AffordableTables[i] draws by Weight among CachedRows[0..i] with positive weight; entry i is
+	 *  only built where the cost steps up, so any budget maps to one table by binary search. */
+	TArray<FDaAliasTable> AffordableTables;
+	TArray<float> AffordableTableMaxCost;
+	TArray<TArray<int32>> AffordableTableRows;
+
+	TWeakObjectPtr<UDataTable> CachedMonsterTable;
+	FDelegateHandle MonsterTableChangedHandle;
+	bool bSelectionTablesDirty = true;
+
+	FRandomStream SelectionStream;
+
+	int32 CurrentWave = INDEX_NONE;
+	float WaveBudgetRemaining = -1.f;
 };
 
 /**
@@ -0,0 +1,111 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DaInteractableRegistrySubsystem.generated.h"
+
+class ULevel;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnInteractablesChanged, AActor* /*Actor*/);
+
+/**
+ * UDaInteractableRegistrySubsystem
+ *
+ * Every actor implementing UDaInteractableInterface in the world (items, pickups, chests,
+ * collectibles), bucketed into a uniform grid of da.InteractableGridCellSize cells. Actors join
+ * when spawned or when their level becomes visible and follow their root component as it moves,
+ * so UDaInteractionComponent's focus search becomes a lookup of a few cells instead of a physics
+ * sweep every frame. Queries and candidates per frame are in `stat DA_GameplayFramework`.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaInteractableRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UDaInteractableRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	void RegisterActor(AActor* Actor);
+	void UnregisterActor(AActor* Actor);
+
+	/**
+	 * The interactable whose bounds come within Radius of the segment Start-End, nearest to Start
+	 * along it; what a sphere sweep of Radius would have hit first. Ignores Ignore and actors with
+	 * collision disabled.
+	 */
+	AActor* FindNearestAlongSegment(const FVector& Start, const FVector& End, float Radius, const AActor* Ignore = nullptr);
+
+	UFUNCTION(BlueprintPure, Category="DA|Interaction")
+	int32 GetNumInteractables() const { return Records.Num(); }
+
+	/** An interactable spawned, was registered or unregistered, or moved. */
+	FOnInteractablesChanged OnInteractablesChanged;
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FInteractableRecord
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** IndexByActor key, kept so a record can still be removed after its actor was collected. */
+		TObjectKey<AActor> Key;
+
+		/** Bounds center when last bucketed, and its offset from the root so moves skip recomputing bounds. */
+		FVector Center = FVector::ZeroVector;
+		FVector CenterOffset = FVector::ZeroVector;
+		float Radius = 0.0f;
+
+		FIntVector Cell = FIntVector::ZeroValue;
+	};
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+	void HandleTransformUpdated(USceneComponent* Component, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	void RegisterLevel(const ULevel* Level);
+
+	/** Picks up the actors of the levels that were already visible before the first query, and
+	 *  registers the actors spawned since the last query (their bounds are final by then). */
+	void FlushPendingRegistrations();
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	/** Measure the actor's bounds; the expensive part, done once on registration. */
+	void RefreshBounds(FInteractableRecord& Record);
+
+	/** Follow the actor's new position, moving the record to another cell if it crossed one. */
+	void UpdateRecord(int32 Index);
+
+	void AddToCell(const FIntVector& Cell, int32 Index);
+	void RemoveFromCell(const FIntVector& Cell, int32 Index);
+	void RemoveRecordAt(int32 Index);
+
+	TArray<FInteractableRecord> Records;
+	TArray<TWeakObjectPtr<AActor>> PendingSpawns;
+	TMap<TObjectKey<AActor>, int32> IndexByActor;
+
+	/** Record indices per grid cell. */
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	/** Largest record radius, how far beyond its cell a record can reach into a query. */
+	float MaxRecordRadius = 0.0f;
+
+	float CellSize = 500.0f;
+	bool bLevelsScanned = false;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -16,6 +16,28 @@ enum class EInteractionType : uint8
 	MouseCursor
 };
 
+UENUM()
+enum class EInteractionQueryMode : uint8
+{
+	// Radius query of UDaInteractableRegistrySubsystem's grid
+	SpatialRegistry,
+	// SweepMultiByObjectType against CollisionChannel every update
+	Sweep
+};
+
+UENUM()
+enum class EInteractionUpdatePolicy : uint8
+{
+	// Re-evaluate focus every tick
+	EveryFrame,
+	// Re-evaluate UpdateRateHz times a second
+	FixedRate,
+	// Re-evaluate only after the view or cursor moved past the thresholds, or the interactable registry changed
+	MovementThreshold,
+	// Re-evaluate only on RequestFocusUpdate and before interacting
+	OnDemand
+};
+
 UENUM()
 enum class EInteractionHighlightType : uint8
 {
@@ -43,6 +65,13 @@ public:
 	
 	UDaInteractionComponent();
 
+	/* Re-evaluate focus: now under OnDemand, on the next tick otherwise. Call when something the trace cannot see changed, e.g. an interactable spawned in view */
+	UFUNCTION(BlueprintCallable, Category = "DA|Interaction")
+	void RequestFocusUpdate();
+
+	UFUNCTION(BlueprintCallable, Category = "DA|Interaction")
+	void SetUpdatePolicy(EInteractionUpdatePolicy NewPolicy);
+
 	// Will return resulting actor if trace resulted in an actor that responds to the Interactable Interface, otherwise returns nullPtr
 	FORCEINLINE TObjectPtr<AActor> GetFocusedActor() {return FocusedActor;}
 
@@ -58,10 +87,25 @@ protected:
 	
 	void FindBestInteractable();
 
+	AActor* SweepForInteractable(const FVector& Start, const FVector& End, bool bDebugDraw) const;
+
 	void CursorTrace();
 	
+	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/* Run the trace for InteractionType and remember the view it ran from */
+	void UpdateFocus();
+
+	/* MovementThreshold policy: has the view or cursor moved far enough since the last UpdateFocus */
+	bool HasViewMovedSinceUpdate() const;
+
+	/* Where the focus trace looks from: pawn eyes for SphereTrace, the player camera for MouseCursor */
+	void GetFocusViewPoint(FVector& OutLocation, FRotator& OutRotation) const;
+
+	/* Tick interval and enabled state for UpdatePolicy */
+	void ApplyUpdatePolicy();
+
 	UPROPERTY()
 	TObjectPtr<AActor> FocusedActor;
 
@@ -73,7 +117,29 @@ protected:
 
 	UPROPERTY(EditAnywhere, Category="DA|Trace")
 	EInteractionHighlightType HighlightType;
+
+	/* How SphereTrace finds candidates; Sweep is the physics fallback for interactables the registry cannot see */
+	UPROPERTY(EditAnywhere, Category="DA|Trace")
+	EInteractionQueryMode QueryMode;
 	
+	UPROPERTY(EditAnywhere, Category="DA|Update")
+	EInteractionUpdatePolicy UpdatePolicy;
+
+	UPROPERTY(EditAnywhere, Category="DA|Update", meta=(ClampMin=1, EditCondition="UpdatePolicy==EInteractionUpdatePolicy::FixedRate"))
+	float UpdateRateHz;
+
+	/* MovementThreshold: distance in cm the view has to move before focus is re-evaluated */
+	UPROPERTY(EditAnywhere, Category="DA|Update", meta=(ClampMin=0, EditCondition="UpdatePolicy==EInteractionUpdatePolicy::MovementThreshold"))
+	float MovementThreshold;
+
+	/* MovementThreshold: degrees the view has to turn before focus is re-evaluated */
+	UPROPERTY(EditAnywhere, Category="DA|Update", meta=(ClampMin=0, EditCondition="UpdatePolicy==EInteractionUpdatePolicy::MovementThreshold"))
+	float RotationThreshold;
+
+	/* MovementThreshold with MouseCursor: pixels the cursor has to move before focus is re-evaluated */
+	UPROPERTY(EditAnywhere, Category="DA|Update", meta=(ClampMin=0, EditCondition="UpdatePolicy==EInteractionUpdatePolicy::MovementThreshold"))
+	float CursorMovementThreshold;
+
 	UPROPERTY(EditDefaultsOnly, Category="DA|Trace")
 	float TraceDistance;
 
@@ -86,15 +152,38 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category="DA|UI")
 	TSubclassOf<UDaWorldUserWidget> DefaultWidgetClass;
 
+	/* Focus widget currently shown, one of FocusWidgets */
 	UPROPERTY()
 	TObjectPtr<UDaWorldUserWidget> DefaultWidgetInstance;
 
+	/* One focus widget per class, created on first use and then only shown and hidden */
+	UPROPERTY()
+	TMap<TSubclassOf<UDaWorldUserWidget>, TObjectPtr<UDaWorldUserWidget>> FocusWidgets;
+
+	/* Collapse the focus widget, it stays in the viewport for the next focus */
+	void HideWidget();
+
+	/* Take every focus widget out of the viewport */
 	void RemoveWidget();
 
 	void HighlightFocusedActor(bool bDebugDraw);
 	void ToggleWidgetOnFocusedActor(bool bDebugDraw);
 	
 	FHitResult CursorHit;
+
+private:
+
+	FVector LastUpdateViewLocation = FVector::ZeroVector;
+	FRotator LastUpdateViewRotation = FRotator::ZeroRotator;
+	FVector2D LastUpdateCursorPosition = FVector2D::ZeroVector;
+
+	bool bHasUpdatedFocus = false;
+	bool bFocusUpdateRequested = false;
+
+	/* MovementThreshold: an interactable spawned, went away or moved, so the view alone no longer decides */
+	void HandleInteractablesChanged(AActor* Actor);
+
+	FDelegateHandle InteractablesChangedHandle;
 	
 public:	
 	// Called every frame
@@ -116,8 +116,9 @@ protected:
 	 *  BeginPlay. */
 	void ApplyDroppedWear();
 
-	/** Item definition for an id, via the asset manager (loaded first, synchronous load second). */
-	static const class UDaItemDefinition* ResolveItemDefinition(const FPrimaryAssetId& InItemDefinitionID);
+	/** Item definition for an id, via UDaItemDefinitionCache. A dropped item's definition is still
+	 *  held by the inventory it came from, so this is a cache hit on the drop path. */
+	const class UDaItemDefinition* ResolveItemDefinition(const FPrimaryAssetId& InItemDefinitionID) const;
 
 	virtual void BeginPlay() override;
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
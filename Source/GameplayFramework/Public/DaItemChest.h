@@ -28,6 +28,7 @@ public:
 
 	virtual void LoadActor_Implementation() override;
 	virtual bool ShouldLoadTransform_Implementation() override;
+	virtual bool SupportsSaveDirtyTracking_Implementation() override;
 	
 	UPROPERTY(BlueprintAssignable, Category="ItemChest")
 	FOnLidOpenedStateChanged OnLidOpenedStateChanged;
@@ -12,6 +12,28 @@ class UProjectileMovementComponent;
 class USphereComponent;
 class UAudioComponent;
 class USoundCue;
+class UDaProjectilePoolSubsystem;
+class UDaProjectileSimulationSubsystem;
+
+/* Replicated flight state of a pooled projectile; Generation bumps on every launch so clients restart it even when the pool reuses it within one net update */
+USTRUCT()
+struct FDaProjectileLaunchState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint8 Generation = 0;
+
+	/* False while the projectile sits hidden in the pool */
+	UPROPERTY()
+	bool bActive = true;
+
+	UPROPERTY()
+	FVector_NetQuantize10 Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+};
 
 UCLASS()
 class GAMEPLAYFRAMEWORK_API ADaProjectile : public AActor
@@ -22,8 +44,20 @@ public:
 	// Sets default values for this actor's properties
 	ADaProjectile();
 
+	/* Done flying: hands the projectile back to UDaProjectilePoolSubsystem, or destroys it when pooling is off or the pool is full */
+	UFUNCTION(BlueprintCallable, Category="Pooling")
+	void ReleaseToPool();
+
+	bool IsActiveInPool() const { return LaunchState.bActive; }
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 
+	/* Let UDaProjectilePoolSubsystem recycle this class instead of destroying it after Explode */
+	UPROPERTY(EditDefaultsOnly, Category="Pooling")
+	bool bAllowPooling = true;
+
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category="Components")
 	TObjectPtr<USphereComponent> SphereComp;
 
@@ -56,10 +90,51 @@ protected:
 	
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
 	void Explode();
+
+	/* Hit sound, hit effect and camera shake at Location; const so the batched simulation can play them from the class default */
+	void PlayImpactCosmetics(const UObject* WorldContextObject, const FVector& Location) const;
+
+	/* Whether UDaProjectileSimulationSubsystem may fly this class as a plain struct. Off for projectiles whose flight itself drives gameplay */
+	virtual bool SupportsBatchedSimulation() const { return true; }
+
+	/* Batched simulation hit something: false plays PlayImpactCosmetics from the class default, true materializes an actor for HandleSimulatedImpact */
+	virtual bool NeedsActorForSimulatedImpact(const FHitResult& Hit) const { return false; }
+
+	/* Called on the actor materialized at the impact point of a batched projectile */
+	virtual void HandleSimulatedImpact(const FHitResult& Hit);
+
+	/* Start of every flight, the first from BeginPlay and every reuse from the pool after */
+	virtual void StartFlight();
+
+	/* Stop movement, effects, audio and timers and hide, ready to sit in the pool */
+	virtual void ResetForPool();
 	
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void PostInitializeComponents() override;
-	
+
+	virtual void LifeSpanExpired() override;
+
+private:
+
+	friend UDaProjectilePoolSubsystem;
+	friend UDaProjectileSimulationSubsystem;
+
+	/* Reuse by the pool: move to SpawnTransform, restore movement and collision, then StartFlight */
+	void LaunchFromPool(const FTransform& SpawnTransform);
+
+	/* Show, re-enable collision and restart movement and effects after a stay in the pool */
+	void RestoreFromPool();
+
+	UFUNCTION()
+	void OnRep_LaunchState();
+
+	UPROPERTY(ReplicatedUsing=OnRep_LaunchState)
+	FDaProjectileLaunchState LaunchState;
+
+	/* Counted as active by the pool, so releasing or destroying it must give the slot back */
+	bool bAcquiredFromPool = false;
 };
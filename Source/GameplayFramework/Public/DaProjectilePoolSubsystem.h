@@ -0,0 +1,77 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DaProjectilePoolSubsystem.generated.h"
+
+class ADaProjectile;
+
+/**
+ * UDaProjectilePoolSubsystem
+ *
+ * Per-class pools of ADaProjectile. Explode hands a projectile back with ReleaseToPool instead of
+ * destroying it, and the next shot of that class reuses it, so rapid fire no longer spawns,
+ * registers components for and garbage collects an actor per shot.
+ *
+ * Server only: clients follow the server's pool transitions through the projectile's replicated
+ * launch state. Parked projectiles are hidden with collision off, which also makes them net
+ * irrelevant. Free pool sizes are capped by da.ProjectilePoolMaxFree per class; the pool can be
+ * disabled with da.ProjectilePooling. Counts and the high-water mark are in `stat DA_GameplayFramework`.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UDaProjectilePoolSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Reuse a parked projectile of Class, or spawn one when the pool is empty. */
+	ADaProjectile* AcquireProjectile(TSubclassOf<ADaProjectile> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator);
+
+	/** Park Projectile for reuse. False when it should be destroyed instead (pooling off or the pool is full). */
+	bool ReleaseProjectile(ADaProjectile* Projectile);
+
+	/** Spawn parked projectiles until Class has at least Count free. */
+	UFUNCTION(BlueprintCallable, Category="Projectile|Pool")
+	void Prewarm(TSubclassOf<ADaProjectile> Class, int32 Count);
+
+	/** An acquired projectile was destroyed rather than released (level unload, external Destroy). */
+	void NotifyProjectileDestroyed(ADaProjectile* Projectile);
+
+	UFUNCTION(BlueprintPure, Category="Projectile|Pool")
+	int32 GetNumActive(TSubclassOf<ADaProjectile> Class) const;
+
+	UFUNCTION(BlueprintPure, Category="Projectile|Pool")
+	int32 GetNumFree(TSubclassOf<ADaProjectile> Class) const;
+
+	/** Most projectiles of Class in flight at once since the world started. */
+	UFUNCTION(BlueprintPure, Category="Projectile|Pool")
+	int32 GetHighWaterMark(TSubclassOf<ADaProjectile> Class) const;
+
+	// UWorldSubsystem
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FProjectilePool
+	{
+		TArray<TWeakObjectPtr<ADaProjectile>> Free;
+		int32 NumActive = 0;
+		int32 HighWaterMark = 0;
+	};
+
+	ADaProjectile* SpawnProjectile(TSubclassOf<ADaProjectile> Class, const FTransform& SpawnTransform, AActor* Owner, APawn* Instigator, bool bParked);
+
+	void UpdateStats() const;
+
+	TMap<TObjectKey<UClass>, FProjectilePool> Pools;
+
+	/** Across all classes, for the stats. */
+	int32 TotalActive = 0;
+	int32 TotalHighWaterMark = 0;
+};
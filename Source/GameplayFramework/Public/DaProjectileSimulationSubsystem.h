@@ -0,0 +1,95 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DaSimulatedImpactRelay.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DaProjectileSimulationSubsystem.generated.h"
+
+class ADaProjectile;
+
+/**
+ * UDaProjectileSimulationSubsystem
+ *
+ * Flies ADaProjectile classes as plain structs instead of actors: one tick steps every position
+ * and sweeps it against COLLISION_PROJECTILE in the same loop, so thousands of shots cost no actor
+ * ticks, movement components, Niagara or audio components. Speed, gravity scale, radius, life
+ * span and impact effects are read from the class default.
+ *
+ * A projectile stops at the first blocking hit, or at an overlap its class reports through
+ * NeedsActorForSimulatedImpact (damage, parry); other overlaps are flown through, as with the
+ * actor. Those impacts materialize an actor from UDaProjectilePoolSubsystem at the hit and hand
+ * it the hit through HandleSimulatedImpact. Impacts that only need cosmetics are multicast once
+ * per tick through an ADaSimulatedImpactRelay and played from the class default everywhere.
+ *
+ * Server only and opt-in per UDaGameplayAbility_Projectile (bUseBatchedSimulation). Flights are
+ * not replicated: clients see the impacts, cosmetic or materialized, but not the projectile in
+ * the air; a game that wants in-flight visuals on the server can draw them from ForEachProjectile.
+ * Capacity is da.MaxSimulatedProjectiles, beyond which abilities fall back to actors.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UDaProjectileSimulationSubsystem* Get(const UObject* WorldContextObject);
+
+	/** Whether Class can be flown here (ADaProjectile::SupportsBatchedSimulation). */
+	static bool CanSimulate(TSubclassOf<ADaProjectile> Class);
+
+	/** Start a simulated flight. False when Class cannot be simulated or the subsystem is at capacity. */
+	bool LaunchProjectile(TSubclassOf<ADaProjectile> Class, const FVector& Location, const FRotator& Rotation, APawn* Instigator);
+
+	/** Visit the position and velocity of every projectile in flight. */
+	void ForEachProjectile(TFunctionRef<void(const FVector& Location, const FVector& Velocity)> Visit) const;
+
+	UFUNCTION(BlueprintPure, Category="Projectile|Simulation")
+	int32 GetNumProjectiles() const { return Projectiles.Num(); }
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Projectiles.Num() > 0; }
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FSimulatedProjectile
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+		float GravityZ = 0.0f;
+		float Radius = 0.0f;
+		float TimeLeft = 0.0f;
+
+		TWeakObjectPtr<UClass> Class;
+		TWeakObjectPtr<APawn> Instigator;
+	};
+
+	struct FPendingImpact
+	{
+		TWeakObjectPtr<UClass> Class;
+		TWeakObjectPtr<APawn> Instigator;
+		FVector Velocity = FVector::ZeroVector;
+		FHitResult Hit;
+	};
+
+	void ResolveImpact(const FPendingImpact& Impact);
+
+	/** Multicast this tick's cosmetic-only impacts, spawning the relay on first use. */
+	void SendImpactCosmetics();
+
+	TArray<FSimulatedProjectile> Projectiles;
+
+	UPROPERTY(Transient)
+	TObjectPtr<ADaSimulatedImpactRelay> ImpactRelay;
+
+	TArray<FDaSimulatedImpactCosmetic> PendingCosmetics;
+
+	/** Scratch kept between ticks so the hot loop does not allocate. */
+	TArray<FPendingImpact> PendingImpacts;
+	TArray<FHitResult> SweepHits;
+};
@@ -23,6 +23,12 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Damage")
 	TSubclassOf<UGameplayEffect> DamageEffect;
 	
+	/* Parry or damage OtherActor; true when the projectile parried or exploded */
+	bool ApplyImpact(AActor* OtherActor, const FHitResult& Hit);
+
+	virtual bool NeedsActorForSimulatedImpact(const FHitResult& Hit) const override;
+	virtual void HandleSimulatedImpact(const FHitResult& Hit) override;
+
 	UFUNCTION()
 	void OnActorOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult & SweepResult);
 	
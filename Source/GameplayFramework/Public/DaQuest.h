@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "DaState.h"
 #include "DaQuest.generated.h"
 
 class UDaQuest;
@@ -35,6 +36,22 @@ protected:
 	UPROPERTY(EditAnywhere)
 	TArray<UDaInputAtom*> QuestActivities;
 
+	// State the quest's machine is in after consuming QuestActivities. Advanced one input at a time
+	// through the quest's compiled transition table, so an update costs the same at the thousandth
+	// kill as at the first. Null until the first input, and for quests evaluated by replay.
+	UPROPERTY(VisibleAnywhere)
+	const UDaState* CurrentState = nullptr;
+
+	// Row of CurrentState in the quest's transition table
+	int32 CurrentStateIndex = INDEX_NONE;
+
+	// The machine stopped reading input (entered a terminating state, or hit an unhandled input
+	// without looping); its result can no longer change
+	bool bMachineHalted = false;
+
+	// Incremental step: consume QuestActivity from CurrentState and return the resulting completion
+	EStateMachineCompletionType AdvanceState(const FDaStateTransitionTable& Table, const UDaInputAtom* QuestActivity);
+
 public:
 
 	// Returns true if quest was completed by new activity
@@ -105,6 +122,24 @@ public:
 
 	virtual void OnSucceed(UDaQuestComponent* QuestStatus) const;
 	virtual void OnFailed(UDaQuestComponent* QuestStatus) const;
+
+	// QuestStateMachine flattened for incremental evaluation, compiled on first use. Null when the
+	// machine uses branch subclasses; such quests replay their history through RunState instead.
+	const FDaStateTransitionTable* GetTransitionTable() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	mutable FDaStateTransitionTable CompiledTable;
+	mutable bool bTableCompiled = false;
+
+#if WITH_EDITOR
+	// UDaState::EditGeneration when CompiledTable was built
+	mutable uint32 CompiledGeneration = 0;
+#endif
 };
 
 UCLASS()
@@ -0,0 +1,101 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DaSaveGame.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "DaSaveActorRegistrySubsystem.generated.h"
+
+class ULevel;
+
+/**
+ * UDaSaveActorRegistrySubsystem
+ *
+ * Every actor implementing UDaSaveInterface in the world, with its last serialized record cached.
+ * Actors join when spawned or when their level becomes visible (the first query picks up whatever
+ * was already loaded) and leave with their level when it streams out, so saving and loading no
+ * longer walk every actor in the world.
+ *
+ * Actors that report SupportsSaveDirtyTracking() are only re-serialized after MarkSaveDirty; the
+ * rest are serialized on every save as before. Transforms are refreshed on every save either way.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaSaveActorRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UDaSaveActorRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	/** Flag Actor's SaveGame properties as changed so the next save re-serializes it. */
+	UFUNCTION(BlueprintCallable, Category="SaveGame")
+	void MarkSaveDirty(AActor* Actor);
+
+	/** Convenience for actors marking themselves: no-op when the world has no registry. */
+	static void MarkSaveDirtyFor(AActor* Actor);
+
+	/** Force every actor to re-serialize on the next save (e.g. after a load rewrote their state). */
+	void MarkAllSaveDirty();
+
+	void RegisterActor(AActor* Actor);
+	void UnregisterActor(AActor* Actor);
+
+	/** Append one record per live saveable actor to OutRecords, serializing only the dirty ones. */
+	void GatherSaveRecords(TArray<FActorSaveData>& OutRecords);
+
+	/** Visit the live saveable actors. Do not spawn or destroy saveable actors from inside Visit. */
+	void ForEachSaveActor(TFunctionRef<void(AActor&)> Visit);
+
+	UFUNCTION(BlueprintPure, Category="SaveGame")
+	int32 GetNumSaveActors() const { return Records.Num(); }
+
+	/** Actors serialized by the last GatherSaveRecords (the rest reused their cached record). */
+	UFUNCTION(BlueprintPure, Category="SaveGame")
+	int32 GetNumSerializedLastSave() const { return NumSerializedLastSave; }
+
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FSaveActorRecord
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** IndexByActor key, kept so a record can still be removed after its actor was collected. */
+		TObjectKey<AActor> Key;
+
+		/** Actor opted into dirty tracking, otherwise it is serialized every save. */
+		bool bTracksDirty = false;
+		bool bDirty = true;
+
+		FActorSaveData Cached;
+	};
+
+	void HandleActorSpawned(AActor* Actor);
+	void HandleLevelAddedToWorld(ULevel* Level, UWorld* World);
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* World);
+
+	void RegisterLevel(const ULevel* Level);
+
+	/** Picks up the actors of the levels that were already visible before the first query. */
+	void EnsureLevelsScanned();
+
+	/** Drops records of destroyed or dying actors. */
+	void PruneRecords();
+	void RemoveRecordAt(int32 Index);
+
+	TArray<FSaveActorRecord> Records;
+	TMap<TObjectKey<AActor>, int32> IndexByActor;
+
+	bool bLevelsScanned = false;
+	int32 NumSerializedLastSave = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
@@ -35,6 +35,43 @@ inline bool operator==(const FActorSaveData& Left, const FActorSaveData& Right)
 	return Left.ActorName == Right.ActorName;
 }
 
+/* Layout revisions of the saved actor records (UDaSaveGame::ActorSaveRecordVersion) */
+namespace EDaActorSaveRecordVersion
+{
+	enum Type : int32
+	{
+		// Written before the field existed: records matched by ActorName, duplicates possible (last one wins)
+		Legacy = 0,
+		// One record per ActorName, looked up through FDaActorSaveIndex on load
+		NameIndexed = 1,
+		// Actor records live in one shard slot per map (UDaSaveGame::MapManifest), not in the main save
+		MapSharded = 2,
+
+		LatestPlusOne,
+		Latest = LatestPlusOne - 1
+	};
+}
+
+/**
+ * ActorName -> record lookup over a SavedActors array, built once per load so restoring each
+ * saveable actor is a hash lookup instead of a scan of every record. Holds a view of the array:
+ * rebuild it if the array is modified.
+ */
+struct GAMEPLAYFRAMEWORK_API FDaActorSaveIndex
+{
+	/* Returns the number of duplicate names found; the later record wins, as it did when every match was applied in order */
+	int32 Build(TConstArrayView<FActorSaveData> InRecords);
+
+	const FActorSaveData* Find(FName ActorName) const;
+
+	int32 Num() const { return IndexByName.Num(); }
+
+private:
+
+	TConstArrayView<FActorSaveData> Records;
+	TMap<FName, int32> IndexByName;
+};
+
 USTRUCT()
 struct FSavedMap
 {
@@ -47,6 +84,47 @@ struct FSavedMap
 	TArray<FActorSaveData> SavedActors;
 };
 
+/* Where one map's actor records are stored, and what they looked like when written */
+USTRUCT()
+struct FDaSavedMapManifestEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString MapAssetName = FString();
+
+	/* Slot holding this map's UDaSavedMapShard, next to the main save slot */
+	UPROPERTY()
+	FString ShardSlotName = FString();
+
+	/* Bumped on every shard write, which goes to a new slot; the previous one is deleted only after
+	 * the main save carrying this entry has landed, so an interrupted save keeps a matching pair */
+	UPROPERTY()
+	int32 Generation = 0;
+
+	/* CRC32 of the serialized shard, checked before its records are applied */
+	UPROPERTY()
+	uint32 Checksum = 0;
+
+	UPROPERTY()
+	int32 NumActors = 0;
+};
+
+/**
+ * One map's actor records. Written only when that map is the one being saved and loaded only when
+ * it is the map being entered, so campaign size no longer scales the cost of a save.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaSavedMapShard : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY()
+	FSavedMap Map;
+};
+
 USTRUCT(BlueprintType)
 struct FSavedAbility
 {
@@ -177,14 +255,57 @@ public:
 	UPROPERTY()
 	TArray<FActorSaveData> SavedActors;
 
+	/* EDaActorSaveRecordVersion the SavedActors were written with; saves that predate it load as Legacy */
+	UPROPERTY()
+	int32 ActorSaveRecordVersion = EDaActorSaveRecordVersion::Legacy;
+
 	UPROPERTY()
 	TArray<FSavedAbility> SavedAbilities;
 	
+	/* Monolithic per-map data from before MapSharded; migrated into shards on load */
 	UPROPERTY()
 	TArray<FSavedMap> SavedMaps;
+
+	/* One entry per map with saved actors, see EDaActorSaveRecordVersion::MapSharded */
+	UPROPERTY()
+	TArray<FDaSavedMapManifestEntry> MapManifest;
 	
+	/* Saved entry for PlayerState, or null if it has none yet */
 	FPlayerSaveData* GetPlayerData(APlayerState* PlayerState);
 
+	/* Saved entry stored under PlayerID (see GetPlayerSaveID), or null */
+	FPlayerSaveData* FindPlayerData(const FString& PlayerID);
+
+	/* Saved entry for PlayerID, added if missing. Other players' entries are kept, so a co-op
+	 * partner who is not connected during a save keeps their progress. */
+	FPlayerSaveData& FindOrAddPlayerData(const FString& PlayerID);
+
+	/* Key a PlayerState's data is stored under: its online unique ID, or "PIE_<n>" (n = position in
+	 * the GameState's PlayerArray) while playing in editor, where unique IDs change every session. */
+	static FString GetPlayerSaveID(const APlayerState* PlayerState);
+
+	virtual void Serialize(FArchive& Ar) override;
+
+	UE_DEPRECATED(5.7, "Only sees SavedMaps of a save not yet migrated to per-map shards. Use UDaSaveGameSubsystem::LoadSavedMap, or GetCurrentSavedMap for the loaded map.")
 	FSavedMap GetSavedMapWithMapName(const FString& InMapName);
+
+	UE_DEPRECATED(5.7, "Only sees SavedMaps of a save not yet migrated to per-map shards. Use FindMapManifestEntry and UDaSaveGameSubsystem::LoadSavedMap.")
+	const FSavedMap* FindSavedMap(const FString& InMapName) const;
+
+	/* Whether InMapName has saved actor records, in a shard or (before migration) in SavedMaps */
 	auto HasMap(const FString& InMapName) -> bool;
+
+	const FDaSavedMapManifestEntry* FindMapManifestEntry(const FString& InMapName) const;
+	FDaSavedMapManifestEntry& FindOrAddMapManifestEntry(const FString& InMapName);
+
+	/* Slot a map's shard is stored in for the main save in SlotName; generation 0 is the pre-generation name */
+	static FString GetMapShardSlotName(const FString& SlotName, const FString& InMapName, int32 Generation = 0);
+
+private:
+
+	/* Rebuilt after every load, kept in sync by FindOrAddPlayerData */
+	void RebuildPlayerIndex();
+
+	TMap<FString, int32> PlayerIndexByID;
+	int32 IndexedPlayerCount = 0;
 };
@@ -3,14 +3,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "DaSaveGame.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
 #include "DaSaveGameSubsystem.generated.h"
 
 class UMVVMViewModelBase;
 class UDaSaveGame;
+class UDaSavedMapShard;
+class USaveGame;
 class APlayerState;
+struct FSavedMap;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSaveGameSignature, class UDaSaveGame*, SaveObject);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSaveGameWriteCompletedSignature, class UDaSaveGame*, SaveObject, bool, bSuccess);
 
 /**
  * 
@@ -51,18 +57,142 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SaveGame")
 	bool ReloadPlayerState(APlayerState* PlayerState);
 
+	// Save object the last load or save worked on (what the next save writes into)
+	UFUNCTION(BlueprintPure, Category="SaveGame")
+	UDaSaveGame* GetCurrentSaveGame() const { return CurrentSaveGame; }
+
+	// Actor records of the current map, loaded on travel from its shard; null before the first load or save
+	const FSavedMap* GetCurrentSavedMap() const;
+
+	// Actor records CurrentSaveGame holds for any map, read from its shard (or from SavedMaps before migration)
+	bool LoadSavedMap(const FString& InMapName, FSavedMap& OutMap);
+
 	UPROPERTY(BlueprintAssignable)
 	FOnSaveGameSignature OnSaveGameLoaded;
 
+	// Fires once the save is on disk. With da.AsyncSaveGame that is a few frames after the request.
 	UPROPERTY(BlueprintAssignable)
 	FOnSaveGameSignature OnSaveGameWritten;
 
+	// Fires for every finished disk write, successful or not
+	UPROPERTY(BlueprintAssignable)
+	FOnSaveGameWriteCompletedSignature OnSaveGameWriteCompleted;
+
+	// True while a save is being written on a worker or waiting behind one
+	UFUNCTION(BlueprintPure, Category="SaveGame")
+	bool IsSaveInFlight() const { return bWriteInFlight || PendingWrites.Num() > 0; }
+
+	// Game thread time spent serializing the last save into memory
+	UFUNCTION(BlueprintPure, Category="SaveGame")
+	float GetLastSnapshotMs() const { return LastSnapshotMs; }
+
+	// Time the last disk write took (on the worker when async)
+	UFUNCTION(BlueprintPure, Category="SaveGame")
+	float GetLastWriteMs() const { return LastWriteMs; }
+
 	// initialize subsystem, good moment to load in SaveGameSettings variables
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
 
 protected:
 	
 	UPROPERTY()
 	TObjectPtr<UDaSaveGame> CurrentSaveGame;
-	
+
+	// Only the current map's shard is ever held; other maps stay on disk until travelled to
+	UPROPERTY()
+	TObjectPtr<UDaSavedMapShard> CurrentMapShard;
+
+private:
+
+	struct FPendingWrite
+	{
+		FString SlotName;
+		int32 SlotIndex = 0;
+		TWeakObjectPtr<USaveGame> SaveObject;
+		TArray<uint8> Bytes;
+		bool bCompress = false;
+
+		// Shard writes: the map they hold and its manifest entry before this write, put back if it fails
+		FString ShardMapName;
+		FDaSavedMapManifestEntry PreviousShardEntry;
+		TWeakObjectPtr<UDaSaveGame> ManifestOwner;
+
+		// Main save writes: shard slots its manifest points at that were not on disk when it was
+		// snapshotted. It is queued behind them and dropped if one of them fails.
+		TArray<FString> RequiredShardSlots;
+
+		// Shard slots this main save no longer references, deleted once it is on disk
+		TArray<FString> SupersededShardSlots;
+	};
+
+	struct FWriteResult
+	{
+		bool bSuccess = false;
+		float WriteMs = 0.0f;
+	};
+
+	/* Serialize CurrentSaveGame (and the current map's shard, if it was re-gathered) on the game thread, then
+	 * compress and write it to the slot (on a worker when da.AsyncSaveGame is set). */
+	void CommitToSlot(const FString& SlotName, int32 SlotIndex);
+
+	bool SnapshotToWrite(USaveGame* SaveObject, const FString& SlotName, int32 SlotIndex, FPendingWrite& OutWrite) const;
+
+	/* Snapshot Shard into a new generation slot and point CurrentSaveGame's manifest at it (checksum
+	 * included) for the main save snapshotted next. The entry is put back if the shard write fails
+	 * (FinishShardWrite); the slot it replaces is retired only once the shard is on disk. */
+	void QueueShardWrite(UDaSavedMapShard* Shard, const FString& SlotName, int32 SlotIndex);
+
+	/* A request for a slot that is already queued behind an in-flight write drops the queued one and
+	 * goes to the back, so a main save always lands after the shard writes queued before it */
+	void QueueWrite(FPendingWrite&& Write);
+
+	/* Is a write of SlotName still queued or on the worker */
+	bool IsSlotUnwritten(const FString& SlotName, int32 SlotIndex) const;
+
+	/* Write on the calling thread and report it through FinishWrite */
+	void WriteNow(const FPendingWrite& Write);
+
+	void StartNextWrite();
+	void OnAsyncWriteFinished(uint32 Serial, TWeakObjectPtr<USaveGame> SaveObject, bool bSuccess, float WriteMs);
+	void FinishWrite(const FPendingWrite& Write, bool bSuccess);
+
+	/* Landed: hand the replaced generation to the main save that points past it. Failed: restore the
+	 * manifest entry and drop the queued main saves that point at the missing slot. */
+	void FinishShardWrite(const FPendingWrite& Write, bool bSuccess);
+
+	/* Blocks until the in-flight write lands, then writes anything still queued synchronously. Every
+	 * write it settles is reported through FinishWrite like any other. */
+	void FlushWrites();
+
+	/* Save object whose newest state is still queued or being written for this slot, the disk copy is stale until then */
+	USaveGame* FindUnwrittenSave(const FString& SlotName, int32 SlotIndex) const;
+
+	/* Current world's package name without the PIE prefix, the key of its shard */
+	FString GetCurrentMapAssetName() const;
+
+	/* Shard for InMapName from the manifest of CurrentSaveGame; null if absent or its checksum does not match */
+	UDaSavedMapShard* LoadMapShard(const FString& SlotName, int32 SlotIndex, const FString& InMapName);
+
+	/* Move SavedActors / SavedMaps of a pre-MapSharded save into shards; returns true if anything moved */
+	bool MigrateMonolithicSave(const FString& SlotName, int32 SlotIndex);
+
+	UDaSavedMapShard* MakeMapShard(const FString& InMapName);
+
+	// Set by WriteSaveGame, CommitToSlot writes the shard only when its records were re-gathered
+	bool bCurrentMapShardDirty = false;
+
+	// Shard generations replaced by a landed shard write, handed to the next main save write
+	TArray<FString> SupersededShardSlots;
+
+	TArray<FPendingWrite> PendingWrites;
+
+	// Slot, object and superseded shards of the write currently on the worker (its bytes live in the task)
+	FPendingWrite InFlightWrite;
+	UE::Tasks::TTask<FWriteResult> InFlightTask;
+	bool bWriteInFlight = false;
+	uint32 InFlightSerial = 0;
+
+	float LastSnapshotMs = 0.0f;
+	float LastWriteMs = 0.0f;
 };
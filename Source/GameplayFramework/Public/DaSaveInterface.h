@@ -28,5 +28,10 @@ public:
 
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
 	void LoadActor();
+
+	/* Return true if the actor calls UDaSaveActorRegistrySubsystem::MarkSaveDirty whenever a SaveGame property
+	 * changes; it is then only re-serialized when marked. Otherwise it is serialized on every save. */
+	UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
+	bool SupportsSaveDirtyTracking();
 	
 };
@@ -0,0 +1,42 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DaSimulatedImpactRelay.generated.h"
+
+class ADaProjectile;
+
+/* One cosmetic-only impact of a simulated projectile */
+USTRUCT()
+struct FDaSimulatedImpactCosmetic
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<ADaProjectile> Class;
+
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+};
+
+/**
+ * ADaSimulatedImpactRelay
+ *
+ * Replicated stand-in UDaProjectileSimulationSubsystem spawns on the server, since simulated
+ * projectiles have no actor of their own to replicate through. Impacts that only play cosmetics
+ * are gathered over a tick and sent to every client in one unreliable multicast.
+ */
+UCLASS(NotBlueprintable, Transient)
+class GAMEPLAYFRAMEWORK_API ADaSimulatedImpactRelay : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	ADaSimulatedImpactRelay();
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastImpactCosmetics(const TArray<FDaSimulatedImpactCosmetic>& Impacts);
+};
@@ -64,7 +64,16 @@ class GAMEPLAYFRAMEWORK_API UDaBranch : public UDataAsset
 public:
 	// Returns DestinationState on Success, NULL on failure, For subclasses OutDataIndex might be something other than 1, if a branch is made to consume mutliple sources.
 	virtual UDaState* TryBranch(const UObject* RefObject, const TArray<UDaInputAtom*>& DataSource, int32 DataIndex, int32 &OutDataIndex);
-	
+
+	// Read by UDaState::CompileTransitionTable, which flattens plain (input-membership) branches
+	UDaState* GetDestinationState() const { return DestinationState; }
+	bool IsReverseInputTest() const { return bReverseInputTest; }
+	const TArray<UDaInputAtom*>& GetAcceptableInputs() const { return AcceptableInputs; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
 	// State where we will go next if this branch is taken
 	UPROPERTY(EditAnywhere)
@@ -78,6 +87,48 @@ protected:
 	TArray<UDaInputAtom *> AcceptableInputs;
 };
 
+/**
+ * FDaStateTransitionTable
+ *
+ * A state machine flattened to (state x input) -> next state, so it can be advanced one input at
+ * a time with a hash lookup instead of replaying the whole input history through RunState.
+ * Only machines built from plain UDaBranch branches compile: their choice depends on nothing but
+ * the current input. Machines using UDaBranch subclasses (which may read RefObject or consume
+ * several inputs) have no table and keep using RunState.
+ */
+struct GAMEPLAYFRAMEWORK_API FDaStateTransitionTable
+{
+	// Transition results other than "go to state N"
+	static constexpr int32 Loop = -1;	// stay in this state, input consumed
+	static constexpr int32 Halt = -2;	// the run ends in this state; no later input is read
+
+	struct FStateRow
+	{
+		const UDaState* State = nullptr;
+		EStateMachineCompletionType CompletionType = EStateMachineCompletionType::NotAccepted;
+
+		// Entering this state ends the run (bTerminateImmediatly)
+		bool bTerminal = false;
+
+		// Result for every input some branch of this state lists; anything else takes DefaultTransition
+		TMap<const UDaInputAtom*, int32> Transitions;
+		int32 DefaultTransition = Halt;
+	};
+
+	// Every state reachable from the root; the root is index 0
+	TArray<FStateRow> States;
+
+	bool IsValid() const { return States.Num() > 0; }
+
+	// Next state index for Input, or Loop / Halt
+	int32 Advance(int32 StateIndex, const UDaInputAtom* Input) const
+	{
+		const FStateRow& Row = States[StateIndex];
+		const int32* Found = Row.Transitions.Find(Input);
+		return Found ? *Found : Row.DefaultTransition;
+	}
+};
+
 /**
  * 
  */
@@ -97,6 +148,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category="State Machine")
 	virtual FStateMachineResult RunState(const UObject* RefObject, const TArray<UDaInputAtom*>& DataSource, int32 DataIndex = 0, int32 RemainingSteps = -1);
 
+	/* Flatten the machine rooted at this state into OutTable. Gives the same result as RunState from
+	 * index 0 for any input sequence. Returns false (OutTable empty) when a reachable state is a
+	 * UDaState subclass or uses a branch subclass, whose choice cannot be tabulated.
+	 */
+	bool CompileTransitionTable(FDaStateTransitionTable& OutTable) const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Bumped whenever a state or branch is edited, so compiled tables know they are stale
+	static uint32 EditGeneration;
+#endif
+
 protected:
 
 	// Loop. Used when input atom being processed isn't recognized
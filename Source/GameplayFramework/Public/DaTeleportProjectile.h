@@ -29,6 +29,9 @@ protected:
 
 	void TeleportInstigator();
 	
-	virtual void BeginPlay() override;
+	virtual void StartFlight() override;
+
+	// Detonating on a timer and teleporting the instigator need the actor in flight
+	virtual bool SupportsBatchedSimulation() const override { return false; }
 	
 };
@@ -8,6 +8,7 @@
 #include "Inventory/DaInventoryList.h"
 #include "DaInventoryComponent.generated.h"
 
+class UDaInventoryItemBase;
 struct FDaInventoryEntry;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryEntryEvent, const FDaInventoryEntry&, Entry, int32, SlotIndex);
@@ -21,6 +22,65 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryEntryEvent, const FDaIn
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnLoadoutChanged);
 
+/** One batch finished on the server: bCommitted is false when it was rolled back. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryBatchApplied, bool, bCommitted);
+
+/** Kind of one step in an ApplyInventoryBatch call. */
+UENUM(BlueprintType)
+enum class EDaInventoryOpType : uint8
+{
+	/** AddItem(ItemDefinitionID, Count, SlotIndex as hint). The whole Count must fit. */
+	Add,
+	/** RemoveItem(SlotIndex, Count). */
+	Remove,
+	/** MoveItem(SlotIndex, ToSlot). */
+	Move,
+	/** Move Count items off the stack at SlotIndex into a new entry at ToSlot (first free slot when ToSlot < 0). */
+	Split,
+	/** UseItem(SlotIndex). */
+	Use,
+	/** SetItemStat(ItemID, StatTag, Count). */
+	SetStat
+};
+
+/**
+ * FDaInventoryOp
+ * One step of a batched inventory transaction (see UDaInventoryComponent::ApplyInventoryBatch).
+ * Fields an op type does not read are ignored.
+ */
+USTRUCT(BlueprintType)
+struct GAMEPLAYFRAMEWORK_API FDaInventoryOp
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	EDaInventoryOpType Type = EDaInventoryOpType::Add;
+
+	/** Add: the item to add. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	FPrimaryAssetId ItemDefinitionID;
+
+	/** SetStat: the item whose stat is written. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	FGuid ItemID;
+
+	/** Remove / Move / Split / Use: the source slot. Add: the slot hint (-1 for none). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	int32 SlotIndex = INDEX_NONE;
+
+	/** Move / Split: the destination slot. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	int32 ToSlot = INDEX_NONE;
+
+	/** Add / Split: how many. Remove: how many (0 = whole stack). SetStat: the absolute value. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	int32 Count = 1;
+
+	/** SetStat: the Item.Stat leaf to write. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Inventory|Batch")
+	FGameplayTag StatTag;
+};
+
 /**
  * FDaLoadoutEntry
  * One loadout assignment: which inventory item the player wants in which Equip.Slot.*.
@@ -75,21 +135,37 @@ public:
 	/**
 	 * Drop Count items from SlotIndex into the world. Server-authoritative: removes them
 	 * from the inventory and spawns the definition's PickupActorClass (ADaItemActor by
-	 * default) in front of the owner's pawn so it can be picked back up.
+	 * default) in front of the owner's pawn so it can be picked back up. The items leave the
+	 * inventory immediately; the pickup spawns once its class and mesh are streamed in (see
+	 * UDaItemDropSubsystem), which may be a few frames later for a cold asset.
 	 * Count=0 drops the entire stack. Routes to server if called on client.
 	 */
 	UFUNCTION(BlueprintCallable, Category="Inventory")
 	bool DropItem(int32 SlotIndex, int32 Count = 1);
 
+	/**
+	 * Apply Ops in order as one server-side transaction: either every op succeeds, or the
+	 * inventory is rolled back to what it was before the first one and nothing is broadcast.
+	 * Each op is validated by the same rules as its individual Server_* RPC. On commit, listeners
+	 * get one added/removed/changed broadcast per entry that actually differs (not one per op),
+	 * then OnInventoryBatchApplied fires on the owning client. Use ops consume immediately but
+	 * send their Action.UseItem events only after the commit, since an ability cannot be rolled back.
+	 * One reliable RPC per call instead of one per op. Routes to server if called on client
+	 * (optimistic true; the result arrives through OnInventoryBatchApplied).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Inventory|Batch")
+	bool ApplyInventoryBatch(const TArray<FDaInventoryOp>& Ops);
+
 	/** Returns a copy of all inventory entries. */
 	UFUNCTION(BlueprintCallable, Category="Inventory")
 	TArray<FDaInventoryEntry> GetAllEntries() const;
 
 	/**
-	 * Blueprint-compatibility bridge: build UI view-models for the current entries.
+	 * Blueprint-compatibility bridge: UI view-models for the current entries.
 	 * Existing inventory widgets were authored against the pre-FastArray component,
-	 * which exposed GetItems() returning UDaInventoryItemBase*. This rebuilds those
-	 * transient view-models on demand from the FastArray so those widgets keep working.
+	 * which exposed GetItems() returning UDaInventoryItemBase*. These come from the
+	 * ItemID-keyed view-model pool (FindOrCreateItemViewModel), so repeated calls hand back
+	 * the same objects, already up to date, instead of allocating a fresh set each time.
 	 * Prefer binding UMG to UDaInventoryWidgetController for new work.
 	 * BlueprintPure: legacy widgets call this as a data source without wiring
 	 * exec pins, and impure unconnected nodes get pruned by the compiler.
@@ -97,6 +173,18 @@ public:
 	UFUNCTION(BlueprintPure, Category="Inventory")
 	TArray<class UDaInventoryItemBase*> GetItems();
 
+	/**
+	 * The pooled view-model for Entry's item, created on first request. Pooled view-models are
+	 * keyed by ItemID, refreshed in place from OnEntryChanged (firing their OnInventoryItemUpdated)
+	 * and dropped from the pool when the entry leaves the inventory, so every widget showing an
+	 * item shares one object that never goes stale.
+	 */
+	class UDaInventoryItemBase* FindOrCreateItemViewModel(const FDaInventoryEntry& Entry);
+
+	/** The pooled view-model for ItemID if one has been created, else null. */
+	UFUNCTION(BlueprintPure, Category="Inventory")
+	class UDaInventoryItemBase* FindItemViewModel(FGuid ItemID) const;
+
 	/** Returns a read-only pointer to the entry at the given slot, or nullptr if empty. */
 	const FDaInventoryEntry* GetEntryAtSlot(int32 SlotIndex) const;
 
@@ -243,6 +331,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Inventory|Loadout")
 	FOnLoadoutChanged OnLoadoutChanged;
 
+	/** Fires on the owning client (and standalone/listen host) once per ApplyInventoryBatch. */
+	UPROPERTY(BlueprintAssignable, Category="Inventory|Batch")
+	FOnInventoryBatchApplied OnInventoryBatchApplied;
+
 	// ----- Internal callbacks (called by FDaInventoryEntry FastArray callbacks) -----
 
 	void OnEntryAddedInternal(const FDaInventoryEntry& Entry);
@@ -252,6 +344,7 @@ public:
 protected:
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// ----- Replicated properties -----
@@ -309,6 +402,9 @@ private:
 	UFUNCTION(Server, Reliable)
 	void Server_RepairItem(FGuid ItemID, int32 Points);
 
+	UFUNCTION(Server, Reliable)
+	void Server_ApplyInventoryBatch(const TArray<FDaInventoryOp>& Ops);
+
 	// ----- Client notifications (run on the owning client; locally on standalone/listen host) -----
 
 	UFUNCTION(Client, Reliable)
@@ -317,15 +413,31 @@ private:
 	UFUNCTION(Client, Reliable)
 	void Client_NotifyItemDropped(FDaInventoryEntry Entry);
 
+	UFUNCTION(Client, Reliable)
+	void Client_NotifyInventoryBatchApplied(bool bCommitted);
+
 	// ----- Internal helpers -----
 
-	/** Server-only logic: loads definition, finds or creates slot, adds or stacks entry. */
-	bool Internal_AddItem(FPrimaryAssetId ItemDefinitionID, int32 StackCount, int32 SlotHint);
+	/** Server-only logic: loads definition, finds or creates slot, adds or stacks entry.
+	 *  OutAddedCount (optional) receives how many of StackCount actually fit. */
+	bool Internal_AddItem(FPrimaryAssetId ItemDefinitionID, int32 StackCount, int32 SlotHint, int32* OutAddedCount = nullptr);
+
+	/** Server-only logic: validate and remove Count (0 = all) from the stack at SlotIndex. */
+	bool Internal_RemoveItem(int32 SlotIndex, int32 Count);
+
+	/** Server-only logic: validate the slot range, then move or swap. */
+	bool Internal_MoveItem(int32 FromSlot, int32 ToSlot);
+
+	/** Server-only logic: carve Count off the stack at FromSlot into a new entry at ToSlot. */
+	bool Internal_SplitItem(int32 FromSlot, int32 ToSlot, int32 Count);
+
+	/** Server-only logic: run Ops as one transaction (see ApplyInventoryBatch). */
+	bool Internal_ApplyInventoryBatch(const TArray<FDaInventoryOp>& Ops);
 
 	/** Server-only logic: validate entry, fire gameplay event, consume stack, notify client. */
 	bool Internal_UseItem(int32 SlotIndex);
 
-	/** Server-only logic: remove from inventory and spawn a world pickup actor. */
+	/** Server-only logic: remove from inventory and queue the world pickup on UDaItemDropSubsystem. */
 	bool Internal_DropItem(int32 SlotIndex, int32 Count);
 
 	/** Server-only: find entry, mutate stat, mark dirty, broadcast changed. */
@@ -365,11 +477,21 @@ private:
 	 *  the inventory, so an assignment can never outlive its item. */
 	void ClearLoadoutForItem(const FGuid& ItemID);
 
-	/** Resolve and (if needed) synchronously load the item definition for an ID. */
+	/** Resolve the item definition for an ID through UDaItemDefinitionCache (synchronous load only
+	 *  on a cold miss). */
 	class UDaItemDefinition* ResolveItemDefinition(FPrimaryAssetId ItemDefinitionID) const;
 
 	/** Resolve the pawn that represents this inventory's owner in the world (owner itself or PlayerState's pawn). */
 	AActor* ResolveOwnerAvatar() const;
+
+	/** True while Internal_ApplyInventoryBatch is running: per-entry broadcasts are held back and
+	 *  replaced by one net broadcast per changed entry at commit. */
+	bool bApplyingInventoryBatch = false;
+
+	/** View-models handed out by FindOrCreateItemViewModel, keyed by ItemID. Created lazily, so a
+	 *  dedicated server that never builds UI never allocates one. */
+	UPROPERTY(Transient)
+	TMap<FGuid, TObjectPtr<UDaInventoryItemBase>> ItemViewModels;
 };
 
 /**
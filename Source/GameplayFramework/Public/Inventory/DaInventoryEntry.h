@@ -23,6 +23,9 @@ struct GAMEPLAYFRAMEWORK_API FDaTagStack
 
 	UPROPERTY(BlueprintReadOnly, Category="Inventory")
 	int32 Count = 0;
+
+	bool operator==(const FDaTagStack& Other) const { return Tag == Other.Tag && Count == Other.Count; }
+	bool operator!=(const FDaTagStack& Other) const { return !(*this == Other); }
 };
 
 /**
@@ -94,6 +97,20 @@ struct GAMEPLAYFRAMEWORK_API FDaInventoryEntry : public FFastArraySerializerItem
 	/** Returns true when this entry has a valid ItemID. */
 	bool IsValid() const { return ItemID.IsValid(); }
 
+	/** Returns true when every replicated field matches Other. Replication keys are not compared:
+	 *  copying an entry resets them, so they cannot tell a copy from a changed entry. */
+	bool HasSameContents(const FDaInventoryEntry& Other) const
+	{
+		return ItemID == Other.ItemID
+			&& ItemDefinitionID == Other.ItemDefinitionID
+			&& SlotIndex == Other.SlotIndex
+			&& StackCount == Other.StackCount
+			&& MaxStackCount == Other.MaxStackCount
+			&& Tags == Other.Tags
+			&& AbilitySetID == Other.AbilitySetID
+			&& StatTags == Other.StatTags;
+	}
+
 	/** Returns true when this entry supports stacking. */
 	bool IsStackable() const { return MaxStackCount > 1; }
 
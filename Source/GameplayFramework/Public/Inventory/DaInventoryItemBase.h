@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "Inventory/DaConditionBand.h"
+#include "Inventory/DaInventoryEntry.h"
 #include "DaInventoryItemBase.generated.h"
 
 class UDaAbilitySet;
@@ -12,7 +13,6 @@ class UDaInventoryComponent;
 class UDaItemDefinition;
 class UTexture2D;
 class USlateBrushAsset;
-struct FDaInventoryEntry;
 
 /**
  * FDaInventoryItemData
@@ -76,7 +76,9 @@ public:
 
 	// ----- Factories -----
 
-	/** Build a view-model from a FastArray entry (resolving its item definition). */
+	/** Build a one-off view-model from a FastArray entry (resolving its item definition). For an
+	 *  item still in an inventory prefer UDaInventoryComponent::FindOrCreateItemViewModel, which
+	 *  hands out the pooled one. */
 	static UDaInventoryItemBase* CreateFromEntry(const FDaInventoryEntry& Entry, UObject* Outer);
 
 	/** Legacy convenience factory kept for Blueprint compatibility. */
@@ -119,9 +121,9 @@ public:
 	// ----- Per-instance state (FDaInventoryEntry::StatTags, mirrored for UI) -----
 	// A view-model that showed only the definition's static data could not draw a worn sword
 	// differently from a mint one, which is the whole point of the condition system. These are
-	// copies taken at CreateFromEntry time: the FastArray entry stays the source of truth, and a
-	// changed entry produces a fresh view-model (UDaInventoryWidgetController rebuilds on every
-	// OnEntryChanged), so nothing here goes stale in place.
+	// copies of the backing entry: the FastArray entry stays the source of truth, and the owning
+	// inventory's view-model pool re-copies them (RefreshFromEntry) on every OnEntryChanged, so
+	// nothing here goes stale in place.
 
 	/** Every Item.Stat.* leaf on the backing entry, as tag -> count. */
 	UPROPERTY(BlueprintReadOnly, Category="Inventory|Stats")
@@ -172,6 +174,10 @@ public:
 	/** Populate this view-model from a resolved FastArray entry + definition. */
 	void PopulateFromEntry(const FDaInventoryEntry& Entry, UDaItemDefinition* Definition);
 
+	/** Re-populate in place from Entry, resolving the definition through UDaItemDefinitionCache
+	 *  without blocking (display data fills in, with OnInventoryItemUpdated, once it streams in). */
+	void RefreshFromEntry(const FDaInventoryEntry& Entry);
+
 	virtual void PopulateWithData(const FDaInventoryItemData& Data);
 	virtual FDaInventoryItemData ToData() const;
 	virtual void ClearData();
@@ -242,4 +248,7 @@ protected:
 
 	UPROPERTY(Transient)
 	TWeakObjectPtr<UObject> BaseObject;
+
+	/** Entry this view-model was last refreshed from; re-applied when a streamed definition lands. */
+	FDaInventoryEntry SourceEntry;
 };
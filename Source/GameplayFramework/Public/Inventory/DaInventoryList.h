@@ -23,6 +23,7 @@ struct GAMEPLAYFRAMEWORK_API FDaInventoryList : public FFastArraySerializer
 
 	FDaInventoryList()
 		: OwnerComponent(nullptr)
+		, bIndexesStale(false)
 	{
 	}
 
@@ -33,6 +34,9 @@ struct GAMEPLAYFRAMEWORK_API FDaInventoryList : public FFastArraySerializer
 		return FFastArraySerializer::FastArrayDeltaSerialize<FDaInventoryEntry, FDaInventoryList>(Entries, DeltaParms, *this);
 	}
 
+	/** Runs once per received bunch, after the removals have actually left the array. */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
 	// ----- Mutators -----
 
 	/** Append a new entry and mark it dirty for replication. */
@@ -44,11 +48,34 @@ struct GAMEPLAYFRAMEWORK_API FDaInventoryList : public FFastArraySerializer
 	/** Replace the entry at SlotIndex with Updated data and mark it dirty. */
 	void UpdateEntry(int32 SlotIndex, const FDaInventoryEntry& Updated);
 
+	/** Remove every entry without broadcasting and mark the array dirty. */
+	void EmptyEntries();
+
+	/** Put back a copy of Entries taken earlier, without broadcasting (batch rollback). Restored
+	 *  entries take over the replication ID and key of the live entry with the same ItemID (the
+	 *  copies lost theirs) and are marked dirty only when their contents differ, so entries that
+	 *  end up unchanged are not resent. */
+	void RestoreEntries(const TArray<FDaInventoryEntry>& Snapshot);
+
+	/** Size the slot occupancy bitmap for MaxSize slots up front (it still grows on demand). */
+	void SetSlotCapacity(int32 MaxSize);
+
 	// ----- Queries -----
 
 	/** Find the lowest slot index in [0, MaxSize) that is not occupied. Returns INDEX_NONE if full. */
 	int32 FindFirstEmptySlot(int32 MaxSize) const;
 
+	/**
+	 * Append the Count lowest free slot indices in [0, MaxSize) to OutSlots, ascending, in a single
+	 * pass over the occupancy bitmap. Returns how many were found (fewer than Count when the
+	 * inventory runs out of room). Nothing is held: the caller fills the slots before anything
+	 * else mutates the list — Internal_AddItem uses it to place every overflow stack of one add.
+	 */
+	int32 ReserveSlots(int32 Count, int32 MaxSize, TArray<int32>& OutSlots) const;
+
+	/** Returns true when no entry occupies SlotIndex. */
+	bool IsSlotEmpty(int32 SlotIndex) const;
+
 	/** Find an existing entry that can stack with ForEntry. Returns its slot index or INDEX_NONE. */
 	int32 FindStackableSlot(const FDaInventoryEntry& ForEntry) const;
 
@@ -58,14 +85,50 @@ struct GAMEPLAYFRAMEWORK_API FDaInventoryList : public FFastArraySerializer
 	/** Return a mutable pointer to the entry at SlotIndex, or nullptr. */
 	FDaInventoryEntry* FindBySlotMutable(int32 SlotIndex);
 
+	/** Return a read-only pointer to the entry with the given ItemID, or nullptr. */
+	const FDaInventoryEntry* FindByItemID(const FGuid& ItemID) const;
+
+	/** Return a mutable pointer to the entry with the given ItemID, or nullptr. */
+	FDaInventoryEntry* FindByItemIDMutable(const FGuid& ItemID);
+
 	/** Number of entries currently in the list. */
 	int32 GetCount() const { return Entries.Num(); }
 
 	/** Return a read-only reference to the full entries array. */
 	const TArray<FDaInventoryEntry>& GetEntries() const { return Entries; }
 
+	/** Debug-only: check both lookup indexes against a full scan of Entries. Returns false (and
+	 *  ensures) on the first disagreement. Runs after every mutation when da.InventoryValidateIndexes
+	 *  is set. Compiles out of shipping builds, where it always returns true. */
+	bool ValidateIndexes() const;
+
 private:
 
+	/** Position in Entries of the entry at SlotIndex / with ItemID, or INDEX_NONE. */
+	int32 IndexOfSlot(int32 SlotIndex) const;
+	int32 IndexOfItemID(const FGuid& ItemID) const;
+
+	/** Lowest free slot in [StartSlot, MaxSize), scanning the bitmap a word at a time. */
+	int32 FindEmptySlotFrom(int32 StartSlot, int32 MaxSize) const;
+
+	/** Set or clear one slot's occupancy bit, growing the bitmap when a slot lands past its end. */
+	void SetSlotOccupied(int32 SlotIndex, bool bOccupied) const;
+
+	/** Point both indexes at Entries[Index] (authority mutators). */
+	void IndexEntry(int32 Index);
+
+	/** Drop the index keys of Entries[Index], but only where they still name that position: a swap
+	 *  through UpdateEntry briefly has two entries sharing an ItemID. */
+	void UnindexEntry(int32 Index);
+
+	/** Rebuild both indexes from Entries if they were marked stale. */
+	void EnsureIndexes() const;
+	void RebuildIndexes() const;
+
+	/** Client side: the FastArray reshapes Entries underneath us, so the callbacks only flag the
+	 *  indexes and the next lookup rebuilds them. */
+	void MarkIndexesStale() const { bIndexesStale = true; }
+
 	friend FDaInventoryEntry;
 	friend UDaInventoryComponent;
 
@@ -76,6 +139,18 @@ private:
 	// Owning component — set during initialisation, not replicated
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UDaInventoryComponent> OwnerComponent;
+
+	// Non-replicated lookup indexes (not UPROPERTYs): SlotIndex and ItemID -> position in Entries.
+	// The authority keeps them current inline in the mutators; on clients the FastArray callbacks
+	// mark them stale and the next lookup rebuilds. A lookup whose position no longer matches
+	// rebuilds and retries, so a stale index costs speed, never correctness.
+	mutable TMap<int32, int32> SlotToEntryIndex;
+	mutable TMap<FGuid, int32> ItemIDToEntryIndex;
+	mutable bool bIndexesStale;
+
+	// Slot occupancy bitmap, one bit per slot, derived from SlotToEntryIndex and maintained with it.
+	// Slots past the end of the array are free; free-slot queries scan it 32 slots at a time.
+	mutable TArray<uint32> OccupiedSlotWords;
 };
 
 /** Enable NetDeltaSerialize for FDaInventoryList. */
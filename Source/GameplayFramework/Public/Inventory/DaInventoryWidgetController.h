@@ -14,6 +14,29 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryItemsChanged, const TArr
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryItemAtIndexChanged, const TArray<UDaInventoryItemBase*>&, Items, int32, SlotIndex);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryItemAction, UDaInventoryItemBase*, Item, int32, SlotIndex);
 
+/**
+ * FDaInventoryItemsDiff
+ * One incremental change to UDaInventoryWidgetController's item list. Removed indices refer to
+ * the list before the change, Inserted and Updated to the list after it. An updated item is the
+ * same view-model object as before, refreshed in place.
+ */
+USTRUCT(BlueprintType)
+struct GAMEPLAYFRAMEWORK_API FDaInventoryItemsDiff
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="Inventory")
+	TArray<int32> Inserted;
+
+	UPROPERTY(BlueprintReadOnly, Category="Inventory")
+	TArray<int32> Removed;
+
+	UPROPERTY(BlueprintReadOnly, Category="Inventory")
+	TArray<int32> Updated;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryItemsDiff, const TArray<UDaInventoryItemBase*>&, Items, const FDaInventoryItemsDiff&, Diff);
+
 /**
  * UDaInventoryWidgetController
  *
@@ -21,6 +44,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnInventoryItemAction, UDaInventor
  * to the component's per-entry add/remove/change delegates, maintains an array of
  * UDaInventoryItemBase view-models mirroring the current entries, and re-broadcasts
  * changes through the Blueprint-facing delegates the inventory widgets bind to.
+ *
+ * The view-models are the component's pooled ones (FindOrCreateItemViewModel), and the list is
+ * patched per event rather than rebuilt: OnInventoryItemsDiff says which indices were inserted,
+ * removed or updated, so a widget can touch only those rows. OnInventoryChanged and
+ * FOnInventoryItemChanged still fire for widgets that redraw everything.
  */
 UCLASS(Blueprintable)
 class GAMEPLAYFRAMEWORK_API UDaInventoryWidgetController : public UDaWidgetController
@@ -76,6 +104,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="Inventory")
 	FOnInventoryItemAtIndexChanged FOnInventoryItemChanged;
 
+	// Incremental form of the two above: which list indices changed, for widgets that update rows in place
+	UPROPERTY(BlueprintAssignable, Category="Inventory")
+	FOnInventoryItemsDiff OnInventoryItemsDiff;
+
 	// Fires locally after the server confirms an item was used (e.g. play SFX, flash the slot)
 	UPROPERTY(BlueprintAssignable, Category="Inventory")
 	FOnInventoryItemAction OnItemUsed;
@@ -93,9 +125,16 @@ protected:
 	UPROPERTY(Transient, BlueprintReadOnly, Category = "DaInventoryWidgetController")
 	TArray<TObjectPtr<UDaInventoryItemBase>> Items;
 
-	/** Rebuild the entire Items array from the component's current entries. */
+	/** ItemID -> index into Items. */
+	TMap<FGuid, int32> ItemIndexByID;
+
+	/** Rebuild the entire Items array from the component's current entries (initial sync only;
+	 *  every later change is applied incrementally). */
 	void RebuildItems();
 
+	/** Fire OnInventoryItemsDiff plus the legacy whole-list delegates for one change. */
+	void BroadcastDiff(const FDaInventoryItemsDiff& Diff, int32 SlotIndex);
+
 	UFUNCTION()
 	void HandleEntryAdded(const FDaInventoryEntry& Entry, int32 SlotIndex);
 
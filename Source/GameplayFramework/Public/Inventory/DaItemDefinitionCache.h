@@ -0,0 +1,136 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "DaItemDefinitionCache.generated.h"
+
+class UDaItemDefinition;
+struct FStreamableHandle;
+
+/** Called once a definition request settles. Definition is nullptr when the id did not resolve. */
+DECLARE_DELEGATE_OneParam(FDaItemDefinitionLoaded, UDaItemDefinition* /*Definition*/);
+
+/**
+ * FDaItemDefinitionCacheStats
+ * Counters since the game instance started. A healthy session is nearly all Hits; every
+ * BlockingLoad is a hitch some caller could have avoided by preloading.
+ */
+USTRUCT(BlueprintType)
+struct GAMEPLAYFRAMEWORK_API FDaItemDefinitionCacheStats
+{
+	GENERATED_BODY()
+
+	/** Lookups answered from a resident definition. */
+	UPROPERTY(BlueprintReadOnly, Category="Inventory|Cache")
+	int32 Hits = 0;
+
+	/** Lookups that had to start (or join) an async load. */
+	UPROPERTY(BlueprintReadOnly, Category="Inventory|Cache")
+	int32 Misses = 0;
+
+	/** Lookups that could not wait and loaded synchronously on the game thread. */
+	UPROPERTY(BlueprintReadOnly, Category="Inventory|Cache")
+	int32 BlockingLoads = 0;
+
+	/** Definitions currently pinned. */
+	UPROPERTY(BlueprintReadOnly, Category="Inventory|Cache")
+	int32 Resident = 0;
+
+	/** Definitions with an async load in flight. */
+	UPROPERTY(BlueprintReadOnly, Category="Inventory|Cache")
+	int32 Pending = 0;
+
+	/** Definitions whose soft assets (icon, mesh, pickup class, ability set) are held resident
+	 *  because some inventory currently holds the item. */
+	UPROPERTY(BlueprintReadOnly, Category="Inventory|Cache")
+	int32 Held = 0;
+};
+
+/**
+ * UDaItemDefinitionCache
+ *
+ * Game-instance-wide FPrimaryAssetId -> UDaItemDefinition cache. Definitions are streamed through
+ * the AssetManager and pinned once resolved, so the inventory, its view-models and world pickups
+ * stop paying a synchronous TryLoad on the game thread the first time an item shows up.
+ *
+ * Inventories report what they hold (AddHeldReference / RemoveHeldReference, driven from the
+ * entry added/removed broadcasts); for every held item the cache also streams the definition's
+ * soft Icon, DisplayMesh, PickupActorClass and AbilitySetToGrant, so displaying or dropping it
+ * later finds them resident.
+ *
+ * Callers that cannot wait (server-side AddItem validates against the definition before it
+ * returns) use LoadDefinitionBlocking, which still pins the result and is counted separately
+ * so the remaining hitches are visible (`stat DA_GameplayFramework`).
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaItemDefinitionCache : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** The cache of WorldContextObject's game instance, or nullptr outside a game (editor tools, CDOs). */
+	static UDaItemDefinitionCache* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Resolve Id for a caller that cannot wait: through the cache when there is one, else straight
+	 * from the AssetManager (loaded copy first, synchronous load second) like the pre-cache code.
+	 */
+	static UDaItemDefinition* ResolveDefinitionBlocking(const UObject* WorldContextObject, const FPrimaryAssetId& Id);
+
+	/** Non-blocking: the definition if it is resident (pinned here, or already loaded elsewhere), else nullptr. */
+	UDaItemDefinition* FindDefinition(const FPrimaryAssetId& Id);
+
+	/**
+	 * Non-blocking: call OnLoaded with the definition once it is resident. Runs OnLoaded immediately
+	 * on a hit; otherwise starts (or joins) one async AssetManager load per id and runs every waiting
+	 * callback when it completes.
+	 */
+	void RequestDefinition(const FPrimaryAssetId& Id, FDaItemDefinitionLoaded OnLoaded);
+
+	/** Start async loads for all of Ids that are not resident yet (spawners, loot tables, save load). */
+	void PreloadDefinitions(const TArray<FPrimaryAssetId>& Ids);
+
+	/** Blocking: resident definition, else a synchronous load that is pinned and counted. */
+	UDaItemDefinition* LoadDefinitionBlocking(const FPrimaryAssetId& Id);
+
+	/** An inventory now holds one more entry of Id: keep its definition and soft assets resident. */
+	void AddHeldReference(const FPrimaryAssetId& Id);
+
+	/** An inventory let go of one entry of Id; its soft assets are released with the last one. */
+	void RemoveHeldReference(const FPrimaryAssetId& Id);
+
+	UFUNCTION(BlueprintPure, Category="Inventory|Cache")
+	FDaItemDefinitionCacheStats GetStats() const;
+
+	virtual void Deinitialize() override;
+
+private:
+
+	void HandleDefinitionLoaded(FPrimaryAssetId Id);
+
+	/** Pin Def and, when the item is held, stream its soft references. */
+	void StoreDefinition(const FPrimaryAssetId& Id, UDaItemDefinition* Def);
+	void StreamHeldAssets(const FPrimaryAssetId& Id, const UDaItemDefinition& Def);
+
+	void UpdateStats() const;
+
+	/** Resolved definitions, pinned for the life of the game instance (they are small data assets). */
+	UPROPERTY()
+	TMap<FPrimaryAssetId, TObjectPtr<UDaItemDefinition>> Definitions;
+
+	/** In-flight definition loads and the callbacks waiting on each. */
+	TMap<FPrimaryAssetId, TSharedPtr<FStreamableHandle>> PendingLoads;
+	TMap<FPrimaryAssetId, TArray<FDaItemDefinitionLoaded>> PendingCallbacks;
+
+	struct FHeldItem
+	{
+		int32 RefCount = 0;
+		TSharedPtr<FStreamableHandle> AssetsHandle;
+	};
+	TMap<FPrimaryAssetId, FHeldItem> HeldItems;
+
+	mutable FDaItemDefinitionCacheStats Stats;
+};
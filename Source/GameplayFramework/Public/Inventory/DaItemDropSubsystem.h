@@ -0,0 +1,80 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Inventory/DaInventoryEntry.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DaItemDropSubsystem.generated.h"
+
+class ADaItemActor;
+class UStaticMesh;
+struct FStreamableHandle;
+
+/**
+ * UDaItemDropSubsystem
+ *
+ * Server-side spawner for the world pickups of dropped inventory items. The inventory removes the
+ * entry the moment a drop is accepted and hands the spawn here; the pickup class and display mesh
+ * are streamed asynchronously, and the actor is spawned once both are resident. A rare item whose
+ * mesh is cold therefore no longer stalls the server tick for every connected player.
+ *
+ * Spawning is throttled to da.MaxDropSpawnsPerFrame per frame (a "drop everything" burst spreads
+ * over several frames); drops whose assets are already resident and fit this frame's budget spawn
+ * inline, so the common case is unchanged. Queue depth is `stat DA_GameplayFramework`.
+ */
+UCLASS()
+class GAMEPLAYFRAMEWORK_API UDaItemDropSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	static UDaItemDropSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * Spawn a pickup for Entry at SpawnTransform once PickupClass and DisplayMesh are resident.
+	 * bWholeInstance: the entry left the inventory whole, so the pickup carries its snapshot and
+	 * restores the same instance on pickup; otherwise it is a fresh stack of the definition.
+	 * A null PickupClass spawns a plain ADaItemActor.
+	 */
+	void QueueDrop(const FDaInventoryEntry& Entry, bool bWholeInstance, const FTransform& SpawnTransform,
+		const TSoftClassPtr<ADaItemActor>& PickupClass, const TSoftObjectPtr<UStaticMesh>& DisplayMesh);
+
+	/** Drops accepted but not spawned yet. */
+	UFUNCTION(BlueprintPure, Category="Inventory|Drop")
+	int32 GetQueueDepth() const { return PendingDrops.Num(); }
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return PendingDrops.Num() > 0; }
+	virtual void Deinitialize() override;
+
+private:
+
+	struct FPendingDrop
+	{
+		FDaInventoryEntry Entry;
+		bool bWholeInstance = false;
+		FTransform SpawnTransform;
+		TSoftClassPtr<ADaItemActor> PickupClass;
+		TSoftObjectPtr<UStaticMesh> DisplayMesh;
+
+		/** Keeps the streamed assets alive until the spawn; null when they were resident already. */
+		TSharedPtr<FStreamableHandle> AssetsHandle;
+
+		bool IsReady() const;
+	};
+
+	/** Spawns left in this frame's da.MaxDropSpawnsPerFrame budget. */
+	bool ConsumeSpawnBudget();
+
+	void SpawnDrop(const FPendingDrop& Drop);
+	void UpdateQueueStat() const;
+
+	TArray<FPendingDrop> PendingDrops;
+
+	uint64 BudgetFrame = 0;
+	int32 SpawnsThisFrame = 0;
+};
@@ -26,6 +26,13 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category="DA|UI", meta = (ExposeOnSpawn=true))
 	TObjectPtr<AActor> AttachedActor;
 
+	/* Point the widget at NewActor, firing OnAttachedActorChanged if it is a different actor */
+	void SetAttachedActor(AActor* NewActor);
+
+	/* A reused widget is not constructed again when it moves to another actor; refresh anything read from AttachedActor here */
+	UFUNCTION(BlueprintImplementableEvent, Category="DA|UI")
+	void OnAttachedActorChanged(AActor* NewActor);
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="DA|UI", meta = (ExposeOnSpawn=true))
 	FVector WorldOffset;
 };
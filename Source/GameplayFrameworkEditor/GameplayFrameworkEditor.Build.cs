@@ -0,0 +1,26 @@
+using UnrealBuildTool;
+
+public class GameplayFrameworkEditor : ModuleRules
+{
+    public GameplayFrameworkEditor(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "Core", "GameplayFramework",
+            }
+        );
+
+        PrivateDependencyModuleNames.AddRange(
+            new string[]
+            {
+                "CoreUObject",
+                "Engine",
+                "GameplayAbilities",
+                "GameplayTags",
+            }
+        );
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemInterface.h"
+#include "GameplayEffect.h"
+#include "GameFramework/Actor.h"
+#include "DaCombatBenchmarkActor.generated.h"
+
+class UDaAbilitySystemComponent;
+class UDaCharacterAttributeSet;
+class UDaCombatAttributeSet;
+
+/* Combatant stand-in for the benchmark: the ability system setup of an NPC without mesh or movement */
+UCLASS(NotBlueprintable, Transient)
+class ADaCombatBenchmarkActor : public AActor, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	ADaCombatBenchmarkActor();
+
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override;
+
+	/* Init actor info and reset vitals and combat attributes to the benchmark's starting values */
+	void ResetAttributes(float BaseHeal, float BaseManaPerCast);
+
+	UPROPERTY()
+	TObjectPtr<UDaAbilitySystemComponent> AbilitySystemComponent;
+
+	UPROPERTY()
+	TObjectPtr<UDaCharacterAttributeSet> CharacterSet;
+
+	UPROPERTY()
+	TObjectPtr<UDaCombatAttributeSet> CombatSet;
+};
+
+/* Heal whose magnitude comes from UDaMMC_Health */
+UCLASS(NotBlueprintable, Transient)
+class UDaCombatBenchmarkEffect_MMCHeal : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+
+	UDaCombatBenchmarkEffect_MMCHeal();
+};
+
+/* Heal paid with mana through UDaExecution_HealWithMana */
+UCLASS(NotBlueprintable, Transient)
+class UDaCombatBenchmarkEffect_HealWithMana : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+
+	UDaCombatBenchmarkEffect_HealWithMana();
+};
@@ -0,0 +1,305 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "Commandlets/DaCombatBenchmarkCommandlet.h"
+
+#include "AbilitySystemGlobals.h"
+#include "CoreGameplayTags.h"
+#include "DaCombatBenchmarkActor.h"
+#include "DaGameInstanceBase.h"
+#include "AbilitySystem/DaAbilitySystemComponent.h"
+#include "AbilitySystem/Attributes/DaCharacterAttributeSet.h"
+#include "AbilitySystem/Attributes/DaCombatAttributeSet.h"
+#include "AbilitySystem/Attributes/DaExecution_HealWithMana.h"
+#include "AbilitySystem/Effects/DaGameplayEffect_DealDamage.h"
+#include "AbilitySystem/Modifiers/DaMMC_Health.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameplayFramework.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+ADaCombatBenchmarkActor::ADaCombatBenchmarkActor()
+{
+	AbilitySystemComponent = CreateDefaultSubobject<UDaAbilitySystemComponent>(TEXT("AbilityComp"));
+	AbilitySystemComponent->SetIsReplicated(true);
+	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
+
+	// Subobjects of the owner are picked up as spawned attributes when the component initializes
+	CharacterSet = CreateDefaultSubobject<UDaCharacterAttributeSet>(TEXT("CharacterSet"));
+	CombatSet = CreateDefaultSubobject<UDaCombatAttributeSet>(TEXT("CombatSet"));
+}
+
+UAbilitySystemComponent* ADaCombatBenchmarkActor::GetAbilitySystemComponent() const
+{
+	return AbilitySystemComponent;
+}
+
+void ADaCombatBenchmarkActor::ResetAttributes(float BaseHeal, float BaseManaPerCast)
+{
+	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+
+	AbilitySystemComponent->SetNumericAttributeBase(UDaCharacterAttributeSet::GetMaxHealthAttribute(), 100.0f);
+	AbilitySystemComponent->SetNumericAttributeBase(UDaCharacterAttributeSet::GetHealthAttribute(), 100.0f);
+	AbilitySystemComponent->SetNumericAttributeBase(UDaCharacterAttributeSet::GetMaxManaAttribute(), 100.0f);
+	AbilitySystemComponent->SetNumericAttributeBase(UDaCharacterAttributeSet::GetManaAttribute(), 100.0f);
+	AbilitySystemComponent->SetNumericAttributeBase(UDaCombatAttributeSet::GetBaseHealAttribute(), BaseHeal);
+	AbilitySystemComponent->SetNumericAttributeBase(UDaCombatAttributeSet::GetBaseManaPerCastAttribute(), BaseManaPerCast);
+}
+
+UDaCombatBenchmarkEffect_MMCHeal::UDaCombatBenchmarkEffect_MMCHeal()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FGameplayModifierInfo Modifier;
+	Modifier.Attribute = UDaCharacterAttributeSet::GetHealingAttribute();
+	FCustomCalculationBasedFloat MagnitudeData = FCustomCalculationBasedFloat();
+	MagnitudeData.CalculationClassMagnitude = UDaMMC_Health::StaticClass();
+	Modifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(MagnitudeData);
+	Modifiers.Add(Modifier);
+}
+
+UDaCombatBenchmarkEffect_HealWithMana::UDaCombatBenchmarkEffect_HealWithMana()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FGameplayEffectExecutionDefinition Execution;
+	Execution.CalculationClass = UDaExecution_HealWithMana::StaticClass();
+	Executions.Add(Execution);
+}
+
+namespace DaCombatBenchmark
+{
+	struct FConfig
+	{
+		int32 NumActors = 100;
+		float Seconds = 10.0f;
+		float TickRate = 30.0f;
+		float DamageRate = 5.0f;
+		float MmcRate = 1.0f;
+		float HealRate = 1.0f;
+		float Damage = 1.0f;
+		int32 NumIterations = 3;
+		FString CsvPath;
+	};
+
+	struct FRow
+	{
+		int32 Iteration = 0;
+		int64 EffectsAttempted = 0;
+		int64 EffectsApplied = 0;
+		int64 AttributeCallbacks = 0;
+		double ApplyMs = 0.0;
+		double TickMs = 0.0;
+		double SpawnMemoryMB = 0.0;
+		double RunMemoryMB = 0.0;
+	};
+
+	static double UsedPhysicalMB()
+	{
+		return FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+	}
+
+	// Whole applications due this tick for an accumulated fractional rate
+	static int32 ConsumeDue(float& Accumulator, float Rate, float DeltaSeconds)
+	{
+		Accumulator += Rate * DeltaSeconds;
+		const int32 Due = FMath::FloorToInt(Accumulator);
+		Accumulator -= Due;
+		return Due;
+	}
+
+	static bool ApplyEffect(UDaAbilitySystemComponent* Source, UDaAbilitySystemComponent* Target, TSubclassOf<UGameplayEffect> EffectClass, float Damage)
+	{
+		const FGameplayEffectSpecHandle SpecHandle = Source->MakeOutgoingSpec(EffectClass, 1.0f, Source->MakeEffectContext());
+		if (!SpecHandle.IsValid())
+		{
+			return false;
+		}
+		SpecHandle.Data->SetSetByCallerMagnitude(CoreGameplayTags::TAG_Event_Damage, Damage);
+		return Source->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), Target).WasSuccessfullyApplied();
+	}
+
+	static bool WriteCsv(const FConfig& Config, const TArray<FRow>& Rows)
+	{
+		FString Csv = TEXT("Iteration,Actors,Seconds,TickRate,DamageRate,MmcRate,HealRate,EffectsAttempted,EffectsApplied,EffectsPerSec,AttributeCallbacks,CallbacksPerSec,ApplyMs,TickMs,SpawnMemoryMB,RunMemoryMB\n");
+		for (const FRow& Row : Rows)
+		{
+			const double ApplySeconds = FMath::Max(Row.ApplyMs / 1000.0, UE_DOUBLE_SMALL_NUMBER);
+			Csv += FString::Printf(TEXT("%d,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%lld,%lld,%.1f,%lld,%.1f,%.3f,%.3f,%.2f,%.2f\n"), Row.Iteration,
+				Config.NumActors, Config.Seconds, Config.TickRate, Config.DamageRate, Config.MmcRate, Config.HealRate,
+				Row.EffectsAttempted, Row.EffectsApplied, Row.EffectsApplied / ApplySeconds, Row.AttributeCallbacks, Row.AttributeCallbacks / ApplySeconds,
+				Row.ApplyMs, Row.TickMs, Row.SpawnMemoryMB, Row.RunMemoryMB);
+		}
+		return FFileHelper::SaveStringToFile(Csv, *Config.CsvPath);
+	}
+}
+
+UDaCombatBenchmarkCommandlet::UDaCombatBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDaCombatBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace DaCombatBenchmark;
+
+	FConfig Config;
+	FParse::Value(*Params, TEXT("Actors="), Config.NumActors);
+	FParse::Value(*Params, TEXT("Seconds="), Config.Seconds);
+	FParse::Value(*Params, TEXT("TickRate="), Config.TickRate);
+	FParse::Value(*Params, TEXT("DamageRate="), Config.DamageRate);
+	FParse::Value(*Params, TEXT("MmcRate="), Config.MmcRate);
+	FParse::Value(*Params, TEXT("HealRate="), Config.HealRate);
+	FParse::Value(*Params, TEXT("Damage="), Config.Damage);
+	FParse::Value(*Params, TEXT("Iterations="), Config.NumIterations);
+	if (!FParse::Value(*Params, TEXT("Csv="), Config.CsvPath))
+	{
+		Config.CsvPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DaCombatBenchmark.csv");
+	}
+	Config.NumActors = FMath::Max(Config.NumActors, 1);
+	Config.Seconds = FMath::Max(Config.Seconds, 0.0f);
+	Config.TickRate = FMath::Max(Config.TickRate, 1.0f);
+	Config.DamageRate = FMath::Max(Config.DamageRate, 0.0f);
+	Config.MmcRate = FMath::Max(Config.MmcRate, 0.0f);
+	Config.HealRate = FMath::Max(Config.HealRate, 0.0f);
+	Config.NumIterations = FMath::Max(Config.NumIterations, 1);
+
+	if (!UAbilitySystemGlobals::Get().IsAbilitySystemGlobalsInitialized())
+	{
+		UAbilitySystemGlobals::Get().InitGlobalData();
+	}
+
+	// A standalone game instance gives a game world to spawn into and tick
+	UDaGameInstanceBase* GameInstance = NewObject<UDaGameInstanceBase>(GEngine);
+	GameInstance->InitializeStandalone();
+
+	UWorld* World = GameInstance->GetWorld();
+	if (World == nullptr)
+	{
+		LOG_ERROR("DaCombatBenchmark: could not create a game world");
+		return 1;
+	}
+
+	AGameStateBase* GameState = World->SpawnActor<AGameStateBase>();
+	World->SetGameState(GameState);
+
+	const double MemoryBeforeSpawnMB = UsedPhysicalMB();
+
+	TArray<ADaCombatBenchmarkActor*> Actors;
+	Actors.Reserve(Config.NumActors);
+	for (int32 ActorIndex = 0; ActorIndex < Config.NumActors; ActorIndex++)
+	{
+		ADaCombatBenchmarkActor* Actor = World->SpawnActor<ADaCombatBenchmarkActor>(FVector(ActorIndex * 100.0f, 0.0f, 0.0f), FRotator::ZeroRotator);
+		Actor->ResetAttributes(10.0f, 1.0f);
+		Actors.Add(Actor);
+	}
+
+	const double SpawnMemoryMB = UsedPhysicalMB() - MemoryBeforeSpawnMB;
+
+	// Every attribute change the ASC broadcasts, which is what UI and gameplay listeners pay for
+	int64 NumAttributeCallbacks = 0;
+	for (ADaCombatBenchmarkActor* Actor : Actors)
+	{
+		for (const UAttributeSet* AttributeSet : Actor->AbilitySystemComponent->GetSpawnedAttributes())
+		{
+			for (TFieldIterator<FProperty> It(AttributeSet->GetClass()); It; ++It)
+			{
+				if (FGameplayAttribute::IsGameplayAttributeDataProperty(*It))
+				{
+					Actor->AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(FGameplayAttribute(*It)).AddLambda(
+						[&NumAttributeCallbacks](const FOnAttributeChangeData&) { NumAttributeCallbacks++; });
+				}
+			}
+		}
+	}
+
+	// The heal execution logs every run, which would measure the log instead of the pipeline
+	const ELogVerbosity::Type PreviousVerbosity = DA_GameplayFramework.GetVerbosity();
+	DA_GameplayFramework.SetVerbosity(ELogVerbosity::Warning);
+
+	const float DeltaSeconds = 1.0f / Config.TickRate;
+	const int32 NumTicks = FMath::CeilToInt(Config.Seconds * Config.TickRate);
+
+	TArray<FRow> Rows;
+	for (int32 Iteration = 0; Iteration < Config.NumIterations; Iteration++)
+	{
+		for (ADaCombatBenchmarkActor* Actor : Actors)
+		{
+			Actor->ResetAttributes(10.0f, 1.0f);
+		}
+		NumAttributeCallbacks = 0;
+
+		FRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Iteration = Iteration;
+		Row.SpawnMemoryMB = SpawnMemoryMB;
+
+		float DamageDue = 0.0f;
+		float MmcDue = 0.0f;
+		float HealDue = 0.0f;
+		for (int32 Tick = 0; Tick < NumTicks; Tick++)
+		{
+			const int32 NumDamage = ConsumeDue(DamageDue, Config.DamageRate, DeltaSeconds);
+			const int32 NumMmc = ConsumeDue(MmcDue, Config.MmcRate, DeltaSeconds);
+			const int32 NumHeal = ConsumeDue(HealDue, Config.HealRate, DeltaSeconds);
+
+			const double ApplyStart = FPlatformTime::Seconds();
+			for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ActorIndex++)
+			{
+				UDaAbilitySystemComponent* Self = Actors[ActorIndex]->AbilitySystemComponent;
+				UDaAbilitySystemComponent* Next = Actors[(ActorIndex + 1) % Actors.Num()]->AbilitySystemComponent;
+
+				for (int32 i = 0; i < NumDamage; i++)
+				{
+					Row.EffectsApplied += ApplyEffect(Self, Next, UDaGameplayEffect_DealDamage::StaticClass(), Config.Damage) ? 1 : 0;
+				}
+				for (int32 i = 0; i < NumMmc; i++)
+				{
+					Row.EffectsApplied += ApplyEffect(Self, Self, UDaCombatBenchmarkEffect_MMCHeal::StaticClass(), Config.Damage) ? 1 : 0;
+				}
+				for (int32 i = 0; i < NumHeal; i++)
+				{
+					Row.EffectsApplied += ApplyEffect(Self, Self, UDaCombatBenchmarkEffect_HealWithMana::StaticClass(), Config.Damage) ? 1 : 0;
+				}
+			}
+			Row.ApplyMs += (FPlatformTime::Seconds() - ApplyStart) * 1000.0;
+			Row.EffectsAttempted += static_cast<int64>(NumDamage + NumMmc + NumHeal) * Actors.Num();
+
+			const double TickStart = FPlatformTime::Seconds();
+			World->Tick(LEVELTICK_All, DeltaSeconds);
+			Row.TickMs += (FPlatformTime::Seconds() - TickStart) * 1000.0;
+		}
+
+		Row.AttributeCallbacks = NumAttributeCallbacks;
+		Row.RunMemoryMB = UsedPhysicalMB() - MemoryBeforeSpawnMB;
+	}
+
+	DA_GameplayFramework.SetVerbosity(PreviousVerbosity);
+
+	for (ADaCombatBenchmarkActor* Actor : Actors)
+	{
+		Actor->Destroy();
+	}
+
+	GameInstance->Shutdown();
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!WriteCsv(Config, Rows))
+	{
+		LOG_ERROR("DaCombatBenchmark: failed to write %s", *Config.CsvPath);
+		return 1;
+	}
+
+	const FRow& Last = Rows.Last();
+	LOG("DaCombatBenchmark: %d actors, %.1f s at %.0f Hz, %d iterations -> %s (last: %lld effects in %.1f ms, %lld attribute callbacks)",
+		Config.NumActors, Config.Seconds, Config.TickRate, Config.NumIterations, *Config.CsvPath,
+		Last.EffectsApplied, Last.ApplyMs, Last.AttributeCallbacks);
+
+	return 0;
+}
@@ -0,0 +1,41 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DaSaveInterface.h"
+#include "GameFramework/Actor.h"
+#include "DaSaveBenchmarkActor.generated.h"
+
+/* Saveable stand-in for the benchmark: a few SaveGame properties of the usual shapes */
+UCLASS(NotBlueprintable, Transient)
+class ADaSaveBenchmarkActor : public AActor, public IDaSaveInterface
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual bool ShouldLoadTransform_Implementation() override { return true; }
+	virtual void LoadActor_Implementation() override {}
+	virtual bool SupportsSaveDirtyTracking_Implementation() override { return bTracksDirty; }
+
+	/* Give every SaveGame property a value derived from Seed */
+	void Fill(int32 Seed, int32 PayloadSize);
+
+	bool bTracksDirty = false;
+
+	UPROPERTY(SaveGame)
+	int32 Counter = 0;
+
+	UPROPERTY(SaveGame)
+	bool bOpened = false;
+
+	UPROPERTY(SaveGame)
+	FString Label;
+
+	UPROPERTY(SaveGame)
+	FVector Offset = FVector::ZeroVector;
+
+	UPROPERTY(SaveGame)
+	TArray<int32> Payload;
+};
@@ -0,0 +1,342 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "Commandlets/DaSaveBenchmarkCommandlet.h"
+
+#include "DaGameInstanceBase.h"
+#include "DaSaveActorRegistrySubsystem.h"
+#include "DaSaveBenchmarkActor.h"
+#include "DaSaveGame.h"
+#include "DaSaveGameSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameplayFramework.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+void ADaSaveBenchmarkActor::Fill(int32 Seed, int32 PayloadSize)
+{
+	Counter = Seed;
+	bOpened = (Seed & 1) != 0;
+	Label = FString::Printf(TEXT("Bench_%d"), Seed);
+	Offset = FVector(Seed, Seed * 2, Seed * 3);
+
+	Payload.SetNumUninitialized(PayloadSize);
+	for (int32 i = 0; i < PayloadSize; i++)
+	{
+		Payload[i] = Seed * 31 + i;
+	}
+}
+
+namespace DaSaveBenchmark
+{
+	static const TCHAR* SlotName = TEXT("DaSaveBenchmark");
+
+	struct FConfig
+	{
+		int32 NumActors = 1000;
+		int32 NumPlayers = 4;
+		int32 NumItems = 40;
+		int32 NumMaps = 8;
+		int32 NumIterations = 5;
+		bool bDirtyTracking = false;
+		FString CsvPath;
+	};
+
+	struct FRow
+	{
+		FString Phase;
+		int32 Iteration = 0;
+		double Ms = 0.0;
+		int64 Bytes = 0;
+		bool bPassed = true;
+	};
+
+	// Same archive setup the save subsystem uses, so equal bytes mean an exact round trip
+	static TArray<uint8> SerializeSaveGameProperties(AActor* Actor)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter MemWriter(Bytes);
+		FObjectAndNameAsStringProxyArchive Ar(MemWriter, true);
+		Ar.ArIsSaveGame = true;
+		Actor->Serialize(Ar);
+		return Bytes;
+	}
+
+	static void FillPlayers(UDaSaveGame* SaveGame, const FConfig& Config)
+	{
+		for (int32 PlayerIndex = 0; PlayerIndex < Config.NumPlayers; PlayerIndex++)
+		{
+			FPlayerSaveData& Data = SaveGame->FindOrAddPlayerData(FString::Printf(TEXT("BenchPlayer_%d"), PlayerIndex));
+			Data.Credits = PlayerIndex * 100;
+			Data.Level = PlayerIndex + 1;
+			Data.Location = FVector(PlayerIndex, 0.0f, 0.0f);
+
+			Data.SavedInventory.SetNum(Config.NumItems);
+			for (int32 ItemIndex = 0; ItemIndex < Config.NumItems; ItemIndex++)
+			{
+				FDaInventoryEntry& Entry = Data.SavedInventory[ItemIndex];
+				Entry.ItemID = FGuid(PlayerIndex, ItemIndex, 0, 1);
+				Entry.ItemDefinitionID = FPrimaryAssetId(TEXT("DaItemDefinition"), *FString::Printf(TEXT("BenchItem_%d"), ItemIndex));
+				Entry.SlotIndex = ItemIndex;
+				Entry.StackCount = 1 + ItemIndex % 5;
+				Entry.MaxStackCount = 5;
+			}
+		}
+	}
+
+	// The maps other than the current one, in the pre-shard layout so the first load has to migrate them
+	static bool WriteMonolithicSave(const FConfig& Config)
+	{
+		UDaSaveGame* Legacy = NewObject<UDaSaveGame>();
+		Legacy->ActorSaveRecordVersion = EDaActorSaveRecordVersion::NameIndexed;
+		FillPlayers(Legacy, Config);
+
+		for (int32 MapIndex = 1; MapIndex < Config.NumMaps; MapIndex++)
+		{
+			FSavedMap& Map = Legacy->SavedMaps.AddDefaulted_GetRef();
+			Map.MapAssetName = FString::Printf(TEXT("/Game/Benchmark/Map_%d"), MapIndex);
+			Map.SavedActors.SetNum(Config.NumActors);
+			for (int32 ActorIndex = 0; ActorIndex < Config.NumActors; ActorIndex++)
+			{
+				FActorSaveData& Record = Map.SavedActors[ActorIndex];
+				Record.ActorName = FName(TEXT("SaveBench"), ActorIndex + 1);
+				Record.ByteData.SetNumZeroed(64);
+			}
+		}
+
+		return UGameplayStatics::SaveGameToSlot(Legacy, SlotName, 0);
+	}
+
+	static bool WriteCsv(const FConfig& Config, const TArray<FRow>& Rows)
+	{
+		FString Csv = TEXT("Phase,Iteration,Actors,Players,ItemsPerPlayer,Maps,DirtyTracking,Ms,Bytes,Passed\n");
+		for (const FRow& Row : Rows)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%d,%d,%d,%d,%d,%.3f,%lld,%d\n"), *Row.Phase, Row.Iteration,
+				Config.NumActors, Config.NumPlayers, Config.NumItems, Config.NumMaps, Config.bDirtyTracking ? 1 : 0,
+				Row.Ms, Row.Bytes, Row.bPassed ? 1 : 0);
+		}
+		return FFileHelper::SaveStringToFile(Csv, *Config.CsvPath);
+	}
+}
+
+UDaSaveBenchmarkCommandlet::UDaSaveBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UDaSaveBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace DaSaveBenchmark;
+
+	FConfig Config;
+	FParse::Value(*Params, TEXT("Actors="), Config.NumActors);
+	FParse::Value(*Params, TEXT("Players="), Config.NumPlayers);
+	FParse::Value(*Params, TEXT("Items="), Config.NumItems);
+	FParse::Value(*Params, TEXT("Maps="), Config.NumMaps);
+	FParse::Value(*Params, TEXT("Iterations="), Config.NumIterations);
+	Config.bDirtyTracking = FParse::Param(*Params, TEXT("DirtyTracking"));
+	if (!FParse::Value(*Params, TEXT("Csv="), Config.CsvPath))
+	{
+		Config.CsvPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / TEXT("DaSaveBenchmark.csv");
+	}
+	Config.NumActors = FMath::Max(Config.NumActors, 0);
+	Config.NumPlayers = FMath::Max(Config.NumPlayers, 0);
+	Config.NumItems = FMath::Max(Config.NumItems, 0);
+	Config.NumMaps = FMath::Max(Config.NumMaps, 1);
+	Config.NumIterations = FMath::Max(Config.NumIterations, 1);
+
+	// End to end means the disk write too, so keep it on this thread for the measurement
+	IConsoleVariable* AsyncSaveCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("da.AsyncSaveGame"));
+	const bool bWasAsync = AsyncSaveCVar && AsyncSaveCVar->GetBool();
+	if (AsyncSaveCVar)
+	{
+		AsyncSaveCVar->Set(false, ECVF_SetByCode);
+	}
+
+	// A standalone game instance owns the save subsystem and a game world to spawn into
+	UDaGameInstanceBase* GameInstance = NewObject<UDaGameInstanceBase>(GEngine);
+	GameInstance->InitializeStandalone();
+	GameInstance->LoadSlotName = SlotName;
+	GameInstance->LoadSlotIndex = 0;
+
+	UWorld* World = GameInstance->GetWorld();
+
+	// Every exit, early ones included, leaves the cvar, the slot and the world as they were
+	ON_SCOPE_EXIT
+	{
+		UDaSaveGameSubsystem::DeleteSlot(SlotName, 0);
+
+		if (AsyncSaveCVar)
+		{
+			AsyncSaveCVar->Set(bWasAsync, ECVF_SetByCode);
+		}
+
+		GameInstance->Shutdown();
+		if (World)
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	};
+
+	UDaSaveGameSubsystem* SaveSubsystem = GameInstance->GetSubsystem<UDaSaveGameSubsystem>();
+	if (World == nullptr || SaveSubsystem == nullptr)
+	{
+		LOG_ERROR("DaSaveBenchmark: could not create a game world with the save subsystem");
+		return 1;
+	}
+
+	AGameStateBase* GameState = World->SpawnActor<AGameStateBase>();
+	World->SetGameState(GameState);
+
+	TArray<ADaSaveBenchmarkActor*> Actors;
+	Actors.Reserve(Config.NumActors);
+	for (int32 ActorIndex = 0; ActorIndex < Config.NumActors; ActorIndex++)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Name = FName(TEXT("SaveBench"), ActorIndex + 1);
+		ADaSaveBenchmarkActor* Actor = World->SpawnActor<ADaSaveBenchmarkActor>(FVector(ActorIndex, 0.0f, 0.0f), FRotator::ZeroRotator, SpawnParams);
+		Actor->bTracksDirty = Config.bDirtyTracking;
+		Actor->Fill(ActorIndex, 16);
+		Actors.Add(Actor);
+	}
+
+	TArray<FRow> Rows;
+	bool bAllPassed = true;
+
+	UDaSaveGameSubsystem::DeleteSlot(SlotName, 0);
+	if (!WriteMonolithicSave(Config))
+	{
+		LOG_ERROR("DaSaveBenchmark: failed to write the monolithic starting save");
+		return 1;
+	}
+
+	// First load splits the other maps into shards
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		SaveSubsystem->LoadSaveGame(SlotName, 0);
+		FRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Phase = TEXT("Migrate");
+		Row.Ms = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		const UDaSaveGame* Migrated = SaveSubsystem->GetCurrentSaveGame();
+		Row.bPassed = Migrated && Migrated->MapManifest.Num() == Config.NumMaps - 1 && Migrated->SavedMaps.Num() == 0;
+		bAllPassed &= Row.bPassed;
+	}
+
+	for (int32 Iteration = 0; Iteration < Config.NumIterations; Iteration++)
+	{
+		// Every actor changes between saves: the worst case for dirty tracking
+		for (ADaSaveBenchmarkActor* Actor : Actors)
+		{
+			Actor->Fill(Actor->Counter + 1, 16);
+			if (Config.bDirtyTracking)
+			{
+				UDaSaveActorRegistrySubsystem::MarkSaveDirtyFor(Actor);
+			}
+		}
+
+		TArray<TArray<uint8>> Expected;
+		Expected.Reserve(Actors.Num());
+		for (ADaSaveBenchmarkActor* Actor : Actors)
+		{
+			Expected.Add(SerializeSaveGameProperties(Actor));
+		}
+
+		// Save
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			SaveSubsystem->SaveInGameProgressData([&Config](UDaSaveGame* SaveData)
+			{
+				FillPlayers(SaveData, Config);
+			});
+			const double SaveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			FRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Phase = TEXT("Save");
+			Row.Iteration = Iteration;
+			Row.Ms = SaveMs;
+
+			FRow& SnapshotRow = Rows.AddDefaulted_GetRef();
+			SnapshotRow.Phase = TEXT("Snapshot");
+			SnapshotRow.Iteration = Iteration;
+			SnapshotRow.Ms = SaveSubsystem->GetLastSnapshotMs();
+
+			FRow& WriteRow = Rows.AddDefaulted_GetRef();
+			WriteRow.Phase = TEXT("Write");
+			WriteRow.Iteration = Iteration;
+			WriteRow.Ms = SaveSubsystem->GetLastWriteMs();
+		}
+
+		// The main save as held in memory must read back from disk identically
+		TArray<uint8> WrittenBytes;
+		TArray<uint8> ReadBytes;
+		UGameplayStatics::SaveGameToMemory(SaveSubsystem->GetCurrentSaveGame(), WrittenBytes);
+
+		// Scramble the live state so the load has to restore every actor
+		for (ADaSaveBenchmarkActor* Actor : Actors)
+		{
+			Actor->Fill(-1, 0);
+			Actor->SetActorLocation(FVector::ZeroVector);
+		}
+
+		// Load
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			SaveSubsystem->LoadSaveGame(SlotName, 0);
+			const double LoadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			UGameplayStatics::SaveGameToMemory(SaveSubsystem->GetCurrentSaveGame(), ReadBytes);
+
+			int32 NumMismatched = 0;
+			for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ActorIndex++)
+			{
+				if (SerializeSaveGameProperties(Actors[ActorIndex]) != Expected[ActorIndex])
+				{
+					NumMismatched++;
+				}
+			}
+
+			const FSavedMap* CurrentMap = SaveSubsystem->GetCurrentSavedMap();
+			const bool bMainMatches = WrittenBytes.Num() > 0 && WrittenBytes == ReadBytes;
+			const bool bShardMatches = CurrentMap && CurrentMap->SavedActors.Num() == Actors.Num();
+
+			FRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Phase = TEXT("Load");
+			Row.Iteration = Iteration;
+			Row.Ms = LoadMs;
+			Row.Bytes = ReadBytes.Num();
+			Row.bPassed = NumMismatched == 0 && bMainMatches && bShardMatches;
+			bAllPassed &= Row.bPassed;
+
+			if (!Row.bPassed)
+			{
+				LOG_ERROR("DaSaveBenchmark: iteration %d round trip differs (%d actor(s) mismatched, main save %s, shard %s)",
+					Iteration, NumMismatched, bMainMatches ? TEXT("ok") : TEXT("differs"), bShardMatches ? TEXT("ok") : TEXT("differs"));
+			}
+		}
+	}
+
+	if (!WriteCsv(Config, Rows))
+	{
+		LOG_ERROR("DaSaveBenchmark: failed to write %s", *Config.CsvPath);
+		return 1;
+	}
+
+	LOG("DaSaveBenchmark: %d actors, %d players x %d items, %d maps, %d iterations -> %s (%s)",
+		Config.NumActors, Config.NumPlayers, Config.NumItems, Config.NumMaps, Config.NumIterations,
+		*Config.CsvPath, bAllPassed ? TEXT("passed") : TEXT("FAILED"));
+
+	return bAllPassed ? 0 : 1;
+}
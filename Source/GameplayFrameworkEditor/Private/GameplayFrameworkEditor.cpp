@@ -0,0 +1,17 @@
+// Copyright Dream Awake Solutions LLC
+
+#include "GameplayFrameworkEditor.h"
+
+#define LOCTEXT_NAMESPACE "FGameplayFrameworkEditorModule"
+
+void FGameplayFrameworkEditorModule::StartupModule()
+{
+}
+
+void FGameplayFrameworkEditorModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FGameplayFrameworkEditorModule, GameplayFrameworkEditor)
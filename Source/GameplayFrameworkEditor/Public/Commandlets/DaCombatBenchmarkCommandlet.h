@@ -0,0 +1,35 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DaCombatBenchmarkCommandlet.generated.h"
+
+/**
+ * UDaCombatBenchmarkCommandlet
+ *
+ * Spawns actors carrying a UDaAbilitySystemComponent with the character and combat attribute sets,
+ * then drives the damage pipeline at fixed rates per actor: UDaGameplayEffect_DealDamage onto the
+ * next actor, an effect whose magnitude comes from UDaMMC_Health, and one running
+ * UDaExecution_HealWithMana. Reports effects/sec, attribute change callbacks/sec and memory.
+ * Headless, so it runs on a build agent:
+ *
+ *   UnrealEditor-Cmd <Project>.uproject -run=DaCombatBenchmark -nullrhi -unattended
+ *       [-Actors=100] [-Seconds=10] [-TickRate=30] [-DamageRate=5] [-MmcRate=1] [-HealRate=1]
+ *       [-Damage=1] [-Iterations=3] [-Csv=<path>]
+ *
+ * Rates are applications per actor per simulated second. Results go to -Csv (default
+ * Saved/Benchmarks/DaCombatBenchmark.csv), one row per iteration.
+ */
+UCLASS()
+class UDaCombatBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UDaCombatBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
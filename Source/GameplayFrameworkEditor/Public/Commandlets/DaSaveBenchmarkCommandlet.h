@@ -0,0 +1,33 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DaSaveBenchmarkCommandlet.generated.h"
+
+/**
+ * UDaSaveBenchmarkCommandlet
+ *
+ * Builds a synthetic world of saveable actors, players with inventories and previously visited maps,
+ * then times UDaSaveGameSubsystem save and load end to end and checks the round trip is byte exact.
+ * Headless, so it runs on a build agent:
+ *
+ *   UnrealEditor-Cmd <Project>.uproject -run=DaSaveBenchmark -nullrhi -unattended
+ *       [-Actors=1000] [-Players=4] [-Items=40] [-Maps=8] [-Iterations=5] [-DirtyTracking] [-Csv=<path>]
+ *
+ * -Maps counts the current map, the others start in the old monolithic format and are migrated to
+ * shards by the first load. Results go to -Csv (default Saved/Benchmarks/DaSaveBenchmark.csv); the
+ * exit code is non-zero when any round trip differs.
+ */
+UCLASS()
+class UDaSaveBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UDaSaveBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
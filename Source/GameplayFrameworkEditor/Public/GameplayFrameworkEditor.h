@@ -0,0 +1,14 @@
+// Copyright Dream Awake Solutions LLC
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/* Editor-only tooling for the framework: commandlets for headless benchmarks and integrity checks */
+class FGameplayFrameworkEditorModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};